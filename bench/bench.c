@@ -0,0 +1,1419 @@
+/**
+ * @file    bench.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ * Benchmark suite for the sorting, matrix, majority, queue and graph algorithms.
+ *
+ * usage: bench [options] [filter...]
+ *   -n sizes      comma separated array sizes                 (default 1000,100000,1000000)
+ *   -g sizes      comma separated graph vertex counts         (default 1000,10000)
+ *   -m sizes      comma separated matrix orders               (default 6,8)
+ *   -d dists      comma separated input distributions         (default all)
+ *   -r reps       repetitions per measurement                 (default 5)
+ *   -t threads    threads for the parallel algorithms, 0=all  (default 0)
+ *   -s seed       random seed                                 (default 1)
+ *   -f format     table, csv or json                          (default table)
+ *   -o file       write results to file instead of stdout
+ *
+ * A filter selects the benchmarks whose name contains it, e.g. "sort/quick" or "dijkstra".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include "../inc/sort.h"
+#include "../inc/matrix.h"
+#include "../inc/majority.h"
+#include "../inc/graphs.h"
+#include "../inc/heap.h"
+#include "../inc/dheap.h"
+#include "../inc/multiqueue.h"
+#include "../inc/threadpool.h"
+#include "../inc/queue.h"
+#include "../inc/csr.h"
+#include "../inc/edgelist.h"
+#include "../inc/p2p.h"
+#include "../inc/ch.h"
+
+#define MAX_LIST        32
+
+#define FORMAT_TABLE    0
+#define FORMAT_CSV      1
+#define FORMAT_JSON     2
+
+/**
+ * @brief Options given on the command line
+ *
+ */
+typedef struct options_s
+{
+    long    sizes[MAX_LIST];        // array sizes
+    int     nsizes;
+    long    gsizes[MAX_LIST];       // graph vertex counts
+    int     ngsizes;
+    long    msizes[MAX_LIST];       // matrix orders
+    int     nmsizes;
+    char*   dists;                  // distributions to run, NULL for all
+    int     reps;
+    int     threads;
+    uint64_t seed;
+    int     format;
+    FILE*   out;
+    char**  filters;
+    int     nfilters;
+
+}options_t;
+
+static options_t opt;
+static int nresults = 0;
+
+/*------------------------------------------------------------------------------
+ * Helpers
+ *----------------------------------------------------------------------------*/
+
+static uint64_t rng_state;
+
+/**
+ * @brief xorshift64* pseudo random generator, reproducible across platforms
+ */
+static inline
+uint64_t rng(void)
+{
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static inline
+int rng_range(int n)
+{
+    return (int)(rng() % (uint64_t)n);
+}
+
+static inline
+double now_ns(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static
+int cmp_double(const void* x, const void* y)
+{
+    double a = *(const double*)x;
+    double b = *(const double*)y;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Nearest-rank percentile of an ascending array of samples
+ */
+static
+double percentile(const double* t, int n, double p)
+{
+    int i = (int)ceil(p * n) - 1;
+
+    if(i < 0)
+        i = 0;
+    if(i >= n)
+        i = n - 1;
+
+    return t[i];
+}
+
+/**
+ * @brief Parse a comma separated list of positive numbers
+ *
+ * @return number of values read
+ */
+static
+int parse_list(const char* s, long* v)
+{
+    int n = 0;
+    char* end;
+
+    while(*s && n < MAX_LIST)
+    {
+        v[n] = strtol(s, &end, 10);
+        if(end == s || v[n] <= 0)
+            break;
+
+        n++;
+        s = (*end == ',') ? end + 1 : end;
+    }
+
+    return n;
+}
+
+/**
+ * @brief True if a benchmark name passes the filters given on the command line
+ */
+static
+bool selected(const char* name)
+{
+    if(opt.nfilters == 0)
+        return true;
+
+    for(int i = 0; i < opt.nfilters; i++)
+    {
+        if(strstr(name, opt.filters[i]))
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief True if an input distribution was requested on the command line
+ */
+static
+bool dist_selected(const char* dist)
+{
+    const char* s = opt.dists;
+    size_t len = strlen(dist);
+
+    if(s == NULL)
+        return true;
+
+    while((s = strstr(s, dist)) != NULL)
+    {
+        bool start = (s == opt.dists || s[-1] == ',');
+        bool end = (s[len] == '\0' || s[len] == ',');
+
+        if(start && end)
+            return true;
+
+        s += len;
+    }
+
+    return false;
+}
+
+/*------------------------------------------------------------------------------
+ * Reporting
+ *----------------------------------------------------------------------------*/
+
+static
+void report_begin(void)
+{
+    switch(opt.format)
+    {
+        case FORMAT_CSV:
+            fprintf(opt.out, "bench,input,n,items,reps,min_ns,median_ns,p90_ns,p99_ns,max_ns,ns_per_item,items_per_sec\n");
+        break;
+
+        case FORMAT_JSON:
+            fprintf(opt.out, "[\n");
+        break;
+
+        default:
+            fprintf(opt.out, "%-28s %-12s %10s %12s %12s %12s %10s %14s\n",
+                    "bench", "input", "n", "median_ns", "p90_ns", "p99_ns", "ns/item", "items/s");
+        break;
+    }
+}
+
+static
+void report_end(void)
+{
+    if(opt.format == FORMAT_JSON)
+        fprintf(opt.out, "\n]\n");
+}
+
+/**
+ * @brief Print the statistics of one measurement
+ *
+ * @param bench benchmark name
+ * @param input input description
+ * @param n problem size
+ * @param items work items processed per run (elements, edges, ...)
+ * @param t run times in nanoseconds, sorted by this function
+ * @param reps number of runs
+ */
+static
+void report(const char* bench, const char* input, long n, long items, double* t, int reps)
+{
+    qsort(t, reps, sizeof(double), cmp_double);
+
+    double med = percentile(t, reps, 0.5);
+    double p90 = percentile(t, reps, 0.9);
+    double p99 = percentile(t, reps, 0.99);
+    double per_item = med / (items > 0 ? items : 1);
+    double rate = (med > 0) ? items * 1e9 / med : 0;
+
+    switch(opt.format)
+    {
+        case FORMAT_CSV:
+            fprintf(opt.out, "%s,%s,%ld,%ld,%d,%.0f,%.0f,%.0f,%.0f,%.0f,%.3f,%.0f\n",
+                    bench, input, n, items, reps, t[0], med, p90, p99, t[reps-1], per_item, rate);
+        break;
+
+        case FORMAT_JSON:
+            fprintf(opt.out, "%s  {\"bench\": \"%s\", \"input\": \"%s\", \"n\": %ld, \"items\": %ld, \"reps\": %d, "
+                    "\"min_ns\": %.0f, \"median_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, \"max_ns\": %.0f, "
+                    "\"ns_per_item\": %.3f, \"items_per_sec\": %.0f}",
+                    nresults ? ",\n" : "", bench, input, n, items, reps, t[0], med, p90, p99, t[reps-1], per_item, rate);
+        break;
+
+        default:
+            fprintf(opt.out, "%-28s %-12s %10ld %12.0f %12.0f %12.0f %10.3f %14.0f\n",
+                    bench, input, n, med, p90, p99, per_item, rate);
+        break;
+    }
+
+    fflush(opt.out);
+    nresults++;
+}
+
+/*------------------------------------------------------------------------------
+ * Arrays
+ *----------------------------------------------------------------------------*/
+
+#define DIST_RANDOM         0
+#define DIST_SORTED         1
+#define DIST_REVERSED       2
+#define DIST_FEW_UNIQUE     3
+#define DIST_ORGAN_PIPE     4
+#define NDIST               5
+
+static const char* dist_names[NDIST] = {"random", "sorted", "reversed", "few_unique", "organ_pipe"};
+
+/**
+ * @brief Fill an array following one of the input distributions
+ */
+static
+void fill_array(int* a, long n, int dist)
+{
+    for(long i = 0; i < n; i++)
+    {
+        switch(dist)
+        {
+            case DIST_RANDOM:       a[i] = (int)rng();                          break;
+            case DIST_SORTED:       a[i] = (int)i;                              break;
+            case DIST_REVERSED:     a[i] = (int)(n - i);                        break;
+            case DIST_FEW_UNIQUE:   a[i] = rng_range(16);                       break;
+            case DIST_ORGAN_PIPE:   a[i] = (int)((i < n/2) ? i : n - i);        break;
+        }
+    }
+}
+
+static void run_mergesort(int* a, int n)            { mergesort(a, 0, n-1); }
+static void run_bottomup_mergesort(int* a, int n)   { bottomup_mergesort(a, n, NULL); }
+static void run_parallel_mergesort(int* a, int n)   { parallel_mergesort(a, 0, n-1, opt.threads); }
+static void run_timsort(int* a, int n)              { timsort(a, n); }
+static void run_heapsort(int* a, int n)             { heapsort(a, n); }
+static void run_quicksort(int* a, int n)            { quicksort(a, 0, n-1); }
+static void run_block_quicksort(int* a, int n)      { quicksort_with(a, 0, n-1, PARTITION_BLOCK); }
+static void run_randomized_quicksort(int* a, int n) { randomized_quicksort(a, 0, n-1); }
+static void run_parallel_quicksort(int* a, int n)   { parallel_quicksort(a, 0, n-1, opt.threads); }
+static void run_radix_sort(int* a, int n)           { radix_sort(a, n); }
+
+/**
+ * @brief A sorting algorithm under test
+ *
+ */
+typedef struct sort_bench_s
+{
+    const char* name;
+    void (*run)(int* a, int n);
+    bool quadratic_on_duplicates;   // skipped on big low-cardinality inputs
+
+}sort_bench_t;
+
+static const sort_bench_t sorts[] =
+{
+    {"sort/mergesort",              run_mergesort,              false},
+    {"sort/bottomup_mergesort",     run_bottomup_mergesort,     false},
+    {"sort/parallel_mergesort",     run_parallel_mergesort,     false},
+    {"sort/timsort",                run_timsort,                false},
+    {"sort/heapsort",               run_heapsort,               false},
+    {"sort/quicksort",              run_quicksort,              false},
+    {"sort/block_quicksort",        run_block_quicksort,        false},
+    {"sort/randomized_quicksort",   run_randomized_quicksort,   true},
+    {"sort/parallel_quicksort",     run_parallel_quicksort,     false},
+    {"sort/radix_sort",             run_radix_sort,             false},
+};
+
+static
+bool is_sorted(const int* a, long n)
+{
+    for(long i = 1; i < n; i++)
+    {
+        if(a[i-1] > a[i])
+            return false;
+    }
+
+    return true;
+}
+
+static
+void bench_sorts(void)
+{
+    double* t = malloc(opt.reps * sizeof(double));
+
+    for(size_t s = 0; s < sizeof(sorts)/sizeof(sorts[0]); s++)
+    {
+        if(!selected(sorts[s].name))
+            continue;
+
+        for(int d = 0; d < NDIST; d++)
+        {
+            if(!dist_selected(dist_names[d]))
+                continue;
+
+            for(int k = 0; k < opt.nsizes; k++)
+            {
+                long n = opt.sizes[k];
+                bool dups = (d != DIST_RANDOM);
+
+                if(sorts[s].quadratic_on_duplicates && dups && n > 20000)
+                    continue;
+
+                int* master = malloc(n * sizeof(int));
+                int* a = malloc(n * sizeof(int));
+                fill_array(master, n, d);
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    memcpy(a, master, n * sizeof(int));
+
+                    double t0 = now_ns();
+                    sorts[s].run(a, (int)n);
+                    t[r] = now_ns() - t0;
+
+                    if(r == 0 && !is_sorted(a, n))
+                        fprintf(stderr, "%s: wrong result on %s n=%ld\n", sorts[s].name, dist_names[d], n);
+                }
+
+                report(sorts[s].name, dist_names[d], n, n, t, opt.reps);
+
+                free(a);
+                free(master);
+            }
+        }
+    }
+
+    free(t);
+}
+
+static
+void bench_majority(void)
+{
+    double* t = malloc(opt.reps * sizeof(double));
+
+    if(!selected("majority"))
+    {
+        free(t);
+        return;
+    }
+
+    for(int d = 0; d < NDIST; d++)
+    {
+        if(!dist_selected(dist_names[d]))
+            continue;
+
+        for(int k = 0; k < opt.nsizes; k++)
+        {
+            long n = opt.sizes[k];
+            int* a = malloc(n * sizeof(int));
+            fill_array(a, n, d);
+
+            for(int r = 0; r < opt.reps; r++)
+            {
+                double t0 = now_ns();
+                volatile int m = majority(a, 0, (int)n - 1);
+                t[r] = now_ns() - t0;
+                (void)m;
+            }
+
+            report("majority", dist_names[d], n, n, t, opt.reps);
+            free(a);
+        }
+    }
+
+    free(t);
+}
+
+static
+void bench_matrix(void)
+{
+    double* t = malloc(opt.reps * sizeof(double));
+
+    if(!selected("det_sq_matrix"))
+    {
+        free(t);
+        return;
+    }
+
+    for(int k = 0; k < opt.nmsizes; k++)
+    {
+        long n = opt.msizes[k];
+        int* m = malloc(n * n * sizeof(int));
+
+        for(long i = 0; i < n*n; i++)
+            m[i] = rng_range(21) - 10;
+
+        for(int r = 0; r < opt.reps; r++)
+        {
+            double t0 = now_ns();
+            volatile float det = det_sq_matrix(m, (int)n);
+            t[r] = now_ns() - t0;
+            (void)det;
+        }
+
+        report("det_sq_matrix", "random", n, n * n, t, opt.reps);
+        free(m);
+    }
+
+    free(t);
+}
+
+/*------------------------------------------------------------------------------
+ * Priority queues
+ *----------------------------------------------------------------------------*/
+
+#define HEAP_INSERT_EXTRACT     0
+#define HEAP_DECREASE_KEY       1
+#define NHEAPWORK               2
+
+static const char* heap_work_names[NHEAPWORK] = {"insert_extract", "decrease_key"};
+
+/**
+ * @brief Run a priority queue workload on keys 0..n-1
+ *
+ * @param arity 0 for the binary heap_t, otherwise the arity of a dheap_t
+ * @param work HEAP_INSERT_EXTRACT: insert all keys with random priorities and extract them all.
+ *             HEAP_DECREASE_KEY: same, with n random decrease-key operations in between
+ * @param prio random priorities of the n keys
+ */
+static
+void run_heap(int arity, int work, const int* prio, int n)
+{
+    key_value_t item;
+    heap_t* heap = NULL;
+    dheap_t* dheap = NULL;
+
+    if(arity)
+        dheap = dheap_create(n, arity);
+    else
+        heap = indexed_min_heap(n);
+
+    for(int i = 0; i < n; i++)
+    {
+        if(arity)
+            dheap_insert(dheap, i, prio[i]);
+        else
+            min_insert(heap, i, prio[i]);
+    }
+
+    if(work == HEAP_DECREASE_KEY)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            int k = prio[i] % n;
+            int v = prio[k] / 2;
+
+            if(arity)
+                dheap_decrease_key(dheap, k, v);
+            else
+                min_decrease_key(heap, k, v);
+        }
+    }
+
+    if(arity)
+    {
+        while(dheap_extract_min(dheap, &item))
+            ;
+        dheap_destroy(dheap);
+    }
+    else
+    {
+        while(extract_min(heap, &item))
+            ;
+        destroy_heap(heap);
+    }
+}
+
+static
+void bench_heaps(void)
+{
+    static const struct { const char* name; int arity; } heaps[] =
+    {
+        {"heap/binary", 0},
+        {"heap/dary4",  4},
+        {"heap/dary8",  8},
+    };
+    double* t = malloc(opt.reps * sizeof(double));
+
+    for(size_t h = 0; h < sizeof(heaps)/sizeof(heaps[0]); h++)
+    {
+        if(!selected(heaps[h].name))
+            continue;
+
+        for(int w = 0; w < NHEAPWORK; w++)
+        {
+            for(int k = 0; k < opt.nsizes; k++)
+            {
+                int n = (int)opt.sizes[k];
+                int* prio = malloc(n * sizeof(int));
+
+                for(int i = 0; i < n; i++)
+                    prio[i] = rng_range(INT_MAX);
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    double t0 = now_ns();
+                    run_heap(heaps[h].arity, w, prio, n);
+                    t[r] = now_ns() - t0;
+                }
+
+                report(heaps[h].name, heap_work_names[w], n, n, t, opt.reps);
+                free(prio);
+            }
+        }
+    }
+
+    free(t);
+}
+
+/*------------------------------------------------------------------------------
+ * Concurrent priority queues
+ *----------------------------------------------------------------------------*/
+
+#define CPQ_MULTIQUEUE  0
+#define CPQ_LOCKED_HEAP 1
+
+/**
+ * @brief Shared state of a concurrent priority queue run
+ *
+ */
+typedef struct cpq_run_s
+{
+    int                 type;       // CPQ_MULTIQUEUE or CPQ_LOCKED_HEAP
+    multiqueue_t*       mq;
+    heap_t*             heap;       // single heap behind a mutex, the baseline
+    pthread_mutex_t     lock;
+    int                 ops;        // extract/insert pairs per thread
+
+}cpq_run_t;
+
+static
+void cpq_insert(cpq_run_t* run, int k, int v)
+{
+    if(run->type == CPQ_MULTIQUEUE)
+    {
+        multiqueue_insert(run->mq, k, v);
+        return;
+    }
+
+    pthread_mutex_lock(&run->lock);
+    min_insert(run->heap, k, v);
+    pthread_mutex_unlock(&run->lock);
+}
+
+static
+int cpq_extract(cpq_run_t* run, key_value_t* item)
+{
+    int r;
+
+    if(run->type == CPQ_MULTIQUEUE)
+        return multiqueue_extract_min(run->mq, item);
+
+    pthread_mutex_lock(&run->lock);
+    r = extract_min(run->heap, item);
+    pthread_mutex_unlock(&run->lock);
+
+    return r;
+}
+
+/**
+ * @brief Each thread takes an item out and puts its key back with a bigger 
+ *        value, the way a parallel label-setting search would
+ */
+static
+void cpq_worker(void* arg)
+{
+    cpq_run_t* run = arg;
+    key_value_t item;
+    uint32_t x = (uint32_t)(uintptr_t)&item | 1;
+
+    for(int i = 0; i < run->ops; i++)
+    {
+        if(!cpq_extract(run, &item))
+            continue;
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+
+        cpq_insert(run, item.key, item.value + (int)(x & 1023));
+    }
+}
+
+/**
+ * @brief Stress check after a run: with n keys inserted and every extracted key 
+ *        put back, draining the queue must return each key exactly once
+ */
+static
+bool cpq_check(cpq_run_t* run, int n)
+{
+    key_value_t item;
+    char* seen = calloc(n, 1);
+    int count = 0;
+    bool ok = true;
+
+    while(cpq_extract(run, &item))
+    {
+        if(item.key < 0 || item.key >= n || seen[item.key]++)
+            ok = false;
+        count++;
+    }
+
+    free(seen);
+
+    return ok && count == n;
+}
+
+static
+void bench_cpq(void)
+{
+    static const struct { const char* name; int type; } cpqs[] =
+    {
+        {"cpq/multiqueue",  CPQ_MULTIQUEUE},
+        {"cpq/locked_heap", CPQ_LOCKED_HEAP},
+    };
+    int maxthreads = opt.threads > 0 ? opt.threads : pool_cpus();
+    double* t = malloc(opt.reps * sizeof(double));
+    char input[32];
+
+    for(size_t q = 0; q < sizeof(cpqs)/sizeof(cpqs[0]); q++)
+    {
+        if(!selected(cpqs[q].name))
+            continue;
+
+        //1, 2, 4, ... threads up to all of them
+        for(int nt = 1; ; nt = (2 * nt < maxthreads) ? 2 * nt : maxthreads)
+        {
+            pool_t* pool = pool_create(nt);
+
+            for(int k = 0; k < opt.nsizes; k++)
+            {
+                int n = (int)opt.sizes[k];
+                cpq_run_t run;
+
+                //at most nt keys are out of the queue at a time
+                if(n <= nt)
+                    continue;
+
+                run.type = cpqs[q].type;
+                run.ops = n / nt > 1 ? n / nt : 1;
+                pthread_mutex_init(&run.lock, NULL);
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    group_t group = {0};
+
+                    run.mq = multiqueue_create(nt, MULTIQUEUE_C);
+                    run.heap = min_heap(n);
+
+                    for(int i = 0; i < n; i++)
+                        cpq_insert(&run, i, rng_range(n));
+
+                    double t0 = now_ns();
+                    for(int i = 0; i < nt; i++)
+                        pool_submit(pool, &group, cpq_worker, &run);
+                    pool_wait(pool, &group);
+                    t[r] = now_ns() - t0;
+
+                    if(!cpq_check(&run, n))
+                    {
+                        fprintf(stderr, "%s: items lost or duplicated with %d threads, n=%d\n", cpqs[q].name, nt, n);
+                        exit(1);
+                    }
+
+                    multiqueue_destroy(run.mq);
+                    destroy_heap(run.heap);
+                }
+
+                pthread_mutex_destroy(&run.lock);
+                snprintf(input, sizeof(input), "threads=%d", nt);
+                report(cpqs[q].name, input, n, (long)run.ops * nt, t, opt.reps);
+            }
+
+            pool_destroy(pool);
+
+            if(nt == maxthreads)
+                break;
+        }
+    }
+
+    free(t);
+}
+
+/*------------------------------------------------------------------------------
+ * Concurrent FIFO queues
+ *----------------------------------------------------------------------------*/
+
+#define FIFO_SPSC       0
+#define FIFO_MPMC       1
+#define FIFO_CAPACITY   1024
+#define FIFO_MAX_BATCH  64
+
+/**
+ * @brief Shared state of a producer/consumer run
+ *
+ */
+typedef struct fifo_run_s
+{
+    int             type;           // FIFO_SPSC or FIFO_MPMC
+    spsc_t*         spsc;
+    mpmc_t*         mpmc;
+    int             batch;          // items per enqueue/dequeue call
+    int             n;              // items sent by each producer
+    atomic_long     left;           // items not received yet
+    atomic_llong    sum;            // sum of the items received
+
+}fifo_run_t;
+
+static
+void* fifo_producer(void* arg)
+{
+    fifo_run_t* run = arg;
+    int buf[FIFO_MAX_BATCH];
+    int i = 1;
+
+    while(i <= run->n)
+    {
+        int k = 0;
+        size_t sent;
+
+        while(k < run->batch && i + k <= run->n)
+        {
+            buf[k] = i + k;
+            k++;
+        }
+
+        if(run->type == FIFO_SPSC)
+            sent = (k == 1) ? spsc_enqueue(run->spsc, buf[0]) : spsc_enqueue_batch(run->spsc, buf, k);
+        else
+            sent = (k == 1) ? mpmc_enqueue(run->mpmc, buf[0]) : mpmc_enqueue_batch(run->mpmc, buf, k);
+
+        //full queue: let a consumer run on an oversubscribed machine
+        if(sent == 0)
+            sched_yield();
+
+        i += (int)sent;
+    }
+
+    return NULL;
+}
+
+static
+void* fifo_consumer(void* arg)
+{
+    fifo_run_t* run = arg;
+    int buf[FIFO_MAX_BATCH];
+    long long sum = 0;
+
+    while(atomic_load_explicit(&run->left, memory_order_relaxed) > 0)
+    {
+        size_t got;
+
+        if(run->type == FIFO_SPSC)
+            got = (run->batch == 1) ? spsc_dequeue(run->spsc, buf) : spsc_dequeue_batch(run->spsc, buf, run->batch);
+        else
+            got = (run->batch == 1) ? mpmc_dequeue(run->mpmc, buf) : mpmc_dequeue_batch(run->mpmc, buf, run->batch);
+
+        if(got == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for(size_t i = 0; i < got; i++)
+            sum += buf[i];
+
+        atomic_fetch_sub(&run->left, (long)got);
+    }
+
+    atomic_fetch_add(&run->sum, sum);
+
+    return NULL;
+}
+
+/**
+ * @brief Time producers sending 1..n each to consumers through a queue. 
+ *        The sum received is checked, so a lost or repeated item stops the bench
+ */
+static
+void bench_fifos(void)
+{
+    static const struct { const char* name; int type; } fifos[] =
+    {
+        {"queue/spsc", FIFO_SPSC},
+        {"queue/mpmc", FIFO_MPMC},
+    };
+    static const int batches[] = {1, 32};
+    int maxthreads = opt.threads > 0 ? opt.threads : pool_cpus();
+    double* t = malloc(opt.reps * sizeof(double));
+    char input[32];
+
+    for(size_t f = 0; f < sizeof(fifos)/sizeof(fifos[0]); f++)
+    {
+        if(!selected(fifos[f].name))
+            continue;
+
+        //SPSC runs one pair, MPMC splits the threads between the two sides
+        int np = (fifos[f].type == FIFO_SPSC || maxthreads < 2) ? 1 : maxthreads / 2;
+        int nc = (fifos[f].type == FIFO_SPSC || maxthreads < 2) ? 1 : maxthreads - np;
+        pthread_t* th = malloc((np + nc) * sizeof(pthread_t));
+
+        for(size_t b = 0; b < sizeof(batches)/sizeof(batches[0]); b++)
+        {
+            for(int k = 0; k < opt.nsizes; k++)
+            {
+                fifo_run_t run;
+                long long expect;
+
+                run.type = fifos[f].type;
+                run.batch = batches[b];
+                run.n = (int)opt.sizes[k];
+                expect = (long long)np * run.n * (run.n + 1) / 2;
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    run.spsc = spsc_create(FIFO_CAPACITY);
+                    run.mpmc = mpmc_create(FIFO_CAPACITY);
+                    atomic_init(&run.left, (long)np * run.n);
+                    atomic_init(&run.sum, 0);
+
+                    double t0 = now_ns();
+                    for(int i = 0; i < np + nc; i++)
+                        pthread_create(&th[i], NULL, i < np ? fifo_producer : fifo_consumer, &run);
+                    for(int i = 0; i < np + nc; i++)
+                        pthread_join(th[i], NULL);
+                    t[r] = now_ns() - t0;
+
+                    if(atomic_load(&run.sum) != expect)
+                    {
+                        fprintf(stderr, "%s: items lost or repeated, batch=%d n=%d\n", fifos[f].name, run.batch, run.n);
+                        exit(1);
+                    }
+
+                    spsc_destroy(run.spsc);
+                    mpmc_destroy(run.mpmc);
+                }
+
+                snprintf(input, sizeof(input), "%dp%dc/batch=%d", np, nc, run.batch);
+                report(fifos[f].name, input, run.n, (long)np * run.n, t, opt.reps);
+            }
+        }
+
+        free(th);
+    }
+
+    free(t);
+}
+
+/*------------------------------------------------------------------------------
+ * Graphs
+ *----------------------------------------------------------------------------*/
+
+#define GRAPH_RANDOM        0
+#define GRAPH_GRID          1
+#define GRAPH_POWER_LAW     2
+#define NGRAPH              3
+
+// average out-degree of the random and power-law graphs
+#define GRAPH_DEGREE        8
+#define GRAPH_MAX_WEIGHT    100
+
+static const char* graph_names[NGRAPH] = {"random", "grid", "power_law"};
+
+/**
+ * @brief Generate a directed graph with random weights in [1,GRAPH_MAX_WEIGHT]
+ *
+ * @param type GRAPH_RANDOM (uniform endpoints), GRAPH_GRID (4-neighbour lattice)
+ *             or GRAPH_POWER_LAW (R-MAT with skewed degree distribution)
+ * @param nv number of vertices
+ * @param ne returns the number of edges
+ * @return graph_t*
+ */
+static
+graph_t* make_graph(int type, int nv, long* ne)
+{
+    graph_t* g = create_graph(nv, DIRECTED);
+    long m = (long)nv * GRAPH_DEGREE;
+    *ne = 0;
+
+    switch(type)
+    {
+        case GRAPH_RANDOM:
+            for(long e = 0; e < m; e++)
+                add_edge(g, rng_range(nv), rng_range(nv), 1 + rng_range(GRAPH_MAX_WEIGHT));
+            *ne = m;
+        break;
+
+        case GRAPH_GRID:
+        {
+            int side = (int)sqrt((double)nv);
+            for(int v = 0; v < side * side; v++)
+            {
+                int x = v % side;
+                int y = v / side;
+
+                if(x + 1 < side)
+                {
+                    add_edge(g, v, v + 1, 1 + rng_range(GRAPH_MAX_WEIGHT));
+                    add_edge(g, v + 1, v, 1 + rng_range(GRAPH_MAX_WEIGHT));
+                    *ne += 2;
+                }
+                if(y + 1 < side)
+                {
+                    add_edge(g, v, v + side, 1 + rng_range(GRAPH_MAX_WEIGHT));
+                    add_edge(g, v + side, v, 1 + rng_range(GRAPH_MAX_WEIGHT));
+                    *ne += 2;
+                }
+            }
+        }
+        break;
+
+        case GRAPH_POWER_LAW:
+        {
+            int scale = 0;
+            while((1L << scale) < nv)
+                scale++;
+
+            for(long e = 0; e < m; )
+            {
+                int u = 0, v = 0;
+
+                //R-MAT: descend into quadrants with probabilities .57 .19 .19 .05
+                for(int b = 0; b < scale; b++)
+                {
+                    int p = rng_range(100);
+                    u <<= 1;
+                    v <<= 1;
+
+                    if(p < 57)
+                        ;
+                    else if(p < 76)
+                        v |= 1;
+                    else if(p < 95)
+                        u |= 1;
+                    else
+                    {
+                        u |= 1;
+                        v |= 1;
+                    }
+                }
+
+                if(u >= nv || v >= nv)
+                    continue;
+
+                add_edge(g, u, v, 1 + rng_range(GRAPH_MAX_WEIGHT));
+                e++;
+            }
+            *ne = m;
+        }
+        break;
+    }
+
+    return g;
+}
+
+static
+void free_sssp(sssp_t* s)
+{
+    if(s == NULL)
+        return;
+
+    free(s->cost);
+    free(s->prev);
+    free(s);
+}
+
+// transpose of the CSR graph being measured, for the bottom-up BFS steps
+static csr_graph_t* bench_csr_in;
+
+// edge list of the graph being measured
+static edge_list_t* bench_el;
+
+static sssp_t* run_csr_bfs_do(csr_graph_t* g, int src)  { return csr_bfs_do(g, bench_csr_in, src); }
+static sssp_t* run_csr_parallel_bfs(csr_graph_t* g, int src) { return csr_parallel_bfs(g, src, opt.threads); }
+static sssp_t* run_bfs(graph_t* g, int src)             { return bfs(g, src); }
+static sssp_t* run_dijkstra(graph_t* g, int src)        { return dijkstra(g, src); }
+static sssp_t* run_dijkstra_dary(graph_t* g, int src)   { return dijkstra_with(g, src, PQ_DARY_HEAP); }
+static sssp_t* run_dijkstra_radix(graph_t* g, int src)  { return dijkstra_with(g, src, PQ_RADIX_HEAP); }
+static sssp_t* run_dijkstra_bucket(graph_t* g, int src) { return dijkstra_with(g, src, PQ_BUCKET_QUEUE); }
+static sssp_t* run_bellman_ford(graph_t* g, int src)    { return bellman_ford(g, src); }
+static sssp_t* run_delta_stepping(graph_t* g, int src)  { return delta_stepping(g, src, 0, opt.threads); }
+static sssp_t* run_spfa(graph_t* g, int src)            { return spfa(g, src, NULL); }
+static sssp_t* run_el_bellman_ford(graph_t* g, int src) { (void)g; return edge_list_bellman_ford(bench_el, src, opt.threads); }
+
+/**
+ * @brief A single source shortest path algorithm under test
+ *
+ */
+typedef struct graph_bench_s
+{
+    const char* name;
+    sssp_t* (*run)(graph_t* g, int src);
+    sssp_t* (*run_csr)(csr_graph_t* g, int src);   // set instead of run for CSR algorithms
+    double max_work;                // skip graphs where V*E exceeds this, 0 for no limit
+
+}graph_bench_t;
+
+static const graph_bench_t graph_benches[] =
+{
+    {"graph/bfs",              run_bfs,              NULL,             0},
+    {"graph/dijkstra",         run_dijkstra,         NULL,             0},
+    {"graph/dijkstra_dary",    run_dijkstra_dary,    NULL,             0},
+    {"graph/dijkstra_radix",   run_dijkstra_radix,   NULL,             0},
+    {"graph/dijkstra_bucket",  run_dijkstra_bucket,  NULL,             0},
+    {"graph/bellman_ford",     run_bellman_ford,     NULL,             1e8},
+    {"graph/delta_stepping",   run_delta_stepping,   NULL,             0},
+    {"graph/spfa",             run_spfa,             NULL,             0},
+    {"graph/el_bellman_ford",  run_el_bellman_ford,  NULL,             1e8},
+    {"graph/csr_bfs",          NULL,                 csr_bfs,          0},
+    {"graph/csr_bfs_do",       NULL,                 run_csr_bfs_do,   0},
+    {"graph/csr_parallel_bfs", NULL,                 run_csr_parallel_bfs, 0},
+    {"graph/csr_dijkstra",     NULL,                 csr_dijkstra,     0},
+    {"graph/csr_bellman_ford", NULL,                 csr_bellman_ford, 1e8},
+};
+
+static
+void bench_graphs(void)
+{
+    double* t = malloc(opt.reps * sizeof(double));
+    size_t nbench = sizeof(graph_benches)/sizeof(graph_benches[0]);
+    bool any = selected("graph/build");
+
+    for(size_t b = 0; b < nbench; b++)
+        any |= selected(graph_benches[b].name);
+
+    for(int type = 0; any && type < NGRAPH; type++)
+    {
+        for(int k = 0; k < opt.ngsizes; k++)
+        {
+            int nv = (int)opt.gsizes[k];
+            long ne;
+            graph_t* g;
+            csr_graph_t* csr;
+
+            //loading and tearing down the adjacency lists. Every run builds the same 
+            //graph as the algorithms below get, whether or not this one is selected
+            if(selected("graph/build"))
+            {
+                uint64_t state = rng_state;
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    rng_state = state;
+
+                    double t0 = now_ns();
+                    g = make_graph(type, nv, &ne);
+                    destroy_graph(g);
+                    t[r] = now_ns() - t0;
+                }
+
+                report("graph/build", graph_names[type], nv, ne, t, opt.reps);
+                rng_state = state;
+            }
+
+            g = make_graph(type, nv, &ne);
+            csr = csr_from_graph(g);
+            bench_csr_in = csr_transpose(csr);
+            bench_el = edge_list_from_graph(g);
+
+            for(size_t b = 0; b < nbench; b++)
+            {
+                const graph_bench_t* gb = &graph_benches[b];
+
+                if(!selected(gb->name))
+                    continue;
+
+                if(gb->max_work > 0 && (double)nv * ne > gb->max_work)
+                    continue;
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    double t0 = now_ns();
+                    sssp_t* s = gb->run_csr ? gb->run_csr(csr, 0) : gb->run(g, 0);
+                    t[r] = now_ns() - t0;
+
+                    free_sssp(s);
+                }
+
+                report(gb->name, graph_names[type], nv, ne, t, opt.reps);
+            }
+
+            edge_list_destroy(bench_el);
+            csr_destroy(bench_csr_in);
+            csr_destroy(csr);
+            destroy_graph(g);
+        }
+    }
+
+    free(t);
+}
+
+// point-to-point queries per measurement
+#define P2P_QUERIES     100
+
+#define P2P_FULL            0
+#define P2P_DIJKSTRA        1
+#define P2P_BIDIRECTIONAL   2
+#define P2P_ASTAR           3
+#define P2P_CH              4
+#define NP2P                5
+
+static const char* p2p_names[NP2P] = {"p2p/dijkstra_full", "p2p/dijkstra", "p2p/bidirectional", "p2p/astar", "p2p/ch"};
+
+// median latency budget of one CH query on a 200x200 grid, scaled by the side of other grids
+#define CH_QUERY_BUDGET_NS  100000
+
+// contraction hierarchy of the graph being queried, and its query context
+static ch_t* bench_ch;
+static ch_query_t* bench_chq;
+
+/**
+ * @brief Answer one src-dst query, with a whole shortest path tree for P2P_FULL
+ */
+static
+int p2p_query(int algo, p2p_t* p, int src, int dst, p2p_coords_t* coords)
+{
+    sssp_t* s;
+    int cost;
+
+    switch(algo)
+    {
+        case P2P_FULL:
+            s = dijkstra(p->g, src);
+            cost = s->cost[dst];
+            free_sssp(s);
+            return cost;
+
+        case P2P_DIJKSTRA:
+            return p2p_dijkstra(p, src, dst, NULL);
+
+        case P2P_BIDIRECTIONAL:
+            return p2p_bidirectional(p, src, dst, NULL);
+
+        case P2P_CH:
+            return ch_query(bench_chq, src, dst, NULL);
+
+        default:
+            return p2p_astar(p, src, dst, p2p_euclidean, coords, NULL);
+    }
+}
+
+/**
+ * @brief Random src-dst queries on the benchmark graphs. A* runs on the grid only, 
+ *        the one graph with coordinates; its weights are at least 1 per unit of distance.
+ *        So does the contraction hierarchy, built and timed once per graph: the random 
+ *        and power-law graphs have no hierarchy and contract into a dense core
+ */
+static
+void bench_p2p(void)
+{
+    double* t = malloc(opt.reps * sizeof(double));
+    bool any = false;
+
+    for(int a = 0; a < NP2P; a++)
+        any |= selected(p2p_names[a]);
+    any |= selected("ch/build") || selected("ch/query");
+
+    for(int type = 0; any && type < NGRAPH; type++)
+    {
+        for(int k = 0; k < opt.ngsizes; k++)
+        {
+            int nv = (int)opt.gsizes[k];
+            int side = (int)sqrt((double)nv);
+            int range = type == GRAPH_GRID ? side * side : nv;
+            int src[P2P_QUERIES], dst[P2P_QUERIES];
+            long ne;
+            graph_t* g = make_graph(type, nv, &ne);
+            p2p_t* p = p2p_create(g);
+            double* x = malloc(nv * sizeof(double));
+            double* y = malloc(nv * sizeof(double));
+            p2p_coords_t coords = {x, y, 1.0};
+
+            for(int v = 0; v < nv; v++)
+            {
+                x[v] = v % side;
+                y[v] = v / side;
+            }
+
+            for(int q = 0; q < P2P_QUERIES; q++)
+            {
+                src[q] = rng_range(range);
+                dst[q] = rng_range(range);
+            }
+
+            bench_ch = NULL;
+            bench_chq = NULL;
+            if(type == GRAPH_GRID && (selected("ch/build") || selected("p2p/ch") || selected("ch/query")))
+            {
+                double t0 = now_ns();
+                bench_ch = ch_build(g);
+                t[0] = now_ns() - t0;
+                bench_chq = ch_query_create(bench_ch);
+
+                if(selected("ch/build"))
+                    report("ch/build", graph_names[type], nv, ne, t, 1);
+            }
+
+            for(int a = 0; a < NP2P; a++)
+            {
+                if(!selected(p2p_names[a]) || (a == P2P_ASTAR && type != GRAPH_GRID) || (a == P2P_CH && !bench_ch))
+                    continue;
+
+                for(int r = 0; r < opt.reps; r++)
+                {
+                    double t0 = now_ns();
+                    for(int q = 0; q < P2P_QUERIES; q++)
+                    {
+                        volatile int cost = p2p_query(a, p, src[q], dst[q], &coords);
+                        (void)cost;
+                    }
+                    t[r] = now_ns() - t0;
+                }
+
+                report(p2p_names[a], graph_names[type], nv, P2P_QUERIES, t, opt.reps);
+            }
+
+            //latency of single CH queries, whose tail the batches above average away
+            if(bench_ch && selected("ch/query"))
+            {
+                int nq = P2P_QUERIES * opt.reps;
+                double* lat = malloc(nq * sizeof(double));
+                double budget = (double)CH_QUERY_BUDGET_NS * side / 200;
+
+                for(int i = 0; i < nq; i++)
+                {
+                    double t0 = now_ns();
+                    volatile int cost = ch_query(bench_chq, src[i % P2P_QUERIES], dst[i % P2P_QUERIES], NULL);
+                    (void)cost;
+                    lat[i] = now_ns() - t0;
+                }
+
+                report("ch/query", graph_names[type], nv, 1, lat, nq);
+                if(percentile(lat, nq, 0.5) > budget)
+                    fprintf(stderr, "ch/query: median %.0f ns over the budget of %.0f ns on %s n=%d\n", 
+                            percentile(lat, nq, 0.5), budget, graph_names[type], nv);
+
+                free(lat);
+            }
+
+            free(x);
+            free(y);
+            ch_query_destroy(bench_chq);
+            ch_destroy(bench_ch);
+            p2p_destroy(p);
+            destroy_graph(g);
+        }
+    }
+
+    free(t);
+}
+
+/*------------------------------------------------------------------------------
+ * Main
+ *----------------------------------------------------------------------------*/
+
+static
+void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-n sizes] [-g graph_sizes] [-m matrix_sizes] [-d dists] "
+                    "[-r reps] [-t threads] [-s seed] [-f table|csv|json] [-o file] [filter...]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    int c;
+
+    opt.nsizes = parse_list("1000,100000,1000000", opt.sizes);
+    opt.ngsizes = parse_list("1000,10000", opt.gsizes);
+    opt.nmsizes = parse_list("6,8", opt.msizes);
+    opt.dists = NULL;
+    opt.reps = 5;
+    opt.threads = 0;
+    opt.seed = 1;
+    opt.format = FORMAT_TABLE;
+    opt.out = stdout;
+
+    while((c = getopt(argc, argv, "n:g:m:d:r:t:s:f:o:h")) != -1)
+    {
+        switch(c)
+        {
+            case 'n': opt.nsizes = parse_list(optarg, opt.sizes);       break;
+            case 'g': opt.ngsizes = parse_list(optarg, opt.gsizes);     break;
+            case 'm': opt.nmsizes = parse_list(optarg, opt.msizes);     break;
+            case 'd': opt.dists = optarg;                               break;
+            case 'r': opt.reps = atoi(optarg);                          break;
+            case 't': opt.threads = atoi(optarg);                       break;
+            case 's': opt.seed = strtoull(optarg, NULL, 10);            break;
+
+            case 'f':
+                if(strcmp(optarg, "csv") == 0)
+                    opt.format = FORMAT_CSV;
+                else if(strcmp(optarg, "json") == 0)
+                    opt.format = FORMAT_JSON;
+                else
+                    opt.format = FORMAT_TABLE;
+            break;
+
+            case 'o':
+                opt.out = fopen(optarg, "w");
+                if(opt.out == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+            break;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if(opt.reps < 1)
+        opt.reps = 1;
+
+    opt.filters = argv + optind;
+    opt.nfilters = argc - optind;
+    rng_state = opt.seed ? opt.seed : 1;
+
+    report_begin();
+    bench_sorts();
+    bench_majority();
+    bench_matrix();
+    bench_heaps();
+    bench_cpq();
+    bench_fifos();
+    bench_graphs();
+    bench_p2p();
+    report_end();
+
+    if(opt.out != stdout)
+        fclose(opt.out);
+
+    return 0;
+}
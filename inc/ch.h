@@ -0,0 +1,135 @@
+/**
+ * @file    ch.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _CH_H_
+#define _CH_H_
+
+#include <stdbool.h>
+#include "graphs.h"
+#include "csr.h"
+#include "dheap.h"
+
+// settled vertices after which a witness search gives up and keeps the shortcut
+#define CH_WITNESS_LIMIT    500
+
+// the same limit when only counting shortcuts to rank vertices
+#define CH_SIMULATE_LIMIT   50
+
+// arity of the query heaps
+#define CH_HEAP_ARITY       4
+
+/**
+ * @brief Contraction hierarchy of a graph with non-negative weights.
+ *        Vertices are ranked by contraction order. The upward graph holds the edges
+ *        u -> v with rank[v] > rank[u], and the downward graph, indexed by the lower
+ *        end, the edges u -> v with rank[u] > rank[v] stored as v -> u. Both keep the
+ *        shortcuts added while contracting, with the vertex each one bypasses.
+ *        Inside the search graphs vertices are numbered by rank, so the top of the
+ *        hierarchy, which every query reaches, is packed at the end of each array.
+ *        A hierarchy is never written after it is built, so any number of threads
+ *        can query it, each through its own ch_query_t
+ *
+ */
+typedef struct ch_s
+{
+    int             nv;             // number of vertices
+    int*            rank;           // contraction order of each vertex
+    int*            vertex;         // vertex of each rank
+    csr_graph_t*    up;
+    csr_graph_t*    down;
+    int*            up_mid;         // rank bypassed by each upward edge, -1 for original edges
+    int*            down_mid;       // same for the downward edges
+
+}ch_t;
+
+/**
+ * @brief Query context of a hierarchy, reused by every query of one thread.
+ *        Vertices are numbered by rank. A query resets the costs of just the 
+ *        vertices the previous one reached, so a query costs its search space only.
+ *        Only the costs are read for every edge scanned: 4 bytes per vertex and 
+ *        search keep them in the cache
+ *
+ */
+typedef struct ch_query_s
+{
+    const ch_t*     ch;
+    int*            cost[2];        // cost of each vertex in the up and down searches, INT_MAX if not reached
+    int*            prev[2];        // parent of each vertex in each search, written only when its cost drops
+    int*            edge[2];        // index of the edge from the parent
+    int*            reached[2];     // vertices reached by each search of the last query
+    int             nreached[2];
+    dheap_t*        q[2];           // indexed heaps, a cost drop is a decrease-key
+    int             touched;        // vertices reached by the last query
+
+}ch_query_t;
+
+
+/**
+ * @brief Build a contraction hierarchy. Vertices are contracted in order of twice the 
+ *        edge difference (shortcuts added minus edges removed), plus contracted neighbours, 
+ *        plus twice the level (longest chain of contracted vertices below), with priorities 
+ *        updated lazily. The level keeps the hierarchy shallow, so queries settle fewer 
+ *        vertices. Contracting v adds a shortcut u -> w for each pair of neighbours unless 
+ *        a witness search from u that avoids v finds a path at least as short; searches 
+ *        stop after CH_WITNESS_LIMIT settled vertices, which only costs extra shortcuts. 
+ *        Suited to road-like graphs: graphs without a hierarchy, such as random ones, 
+ *        contract into a dense core and preprocessing grows much faster than linear
+ *
+ * @param g pointer to graph with non-negative weights
+ * @return ch_t*
+ */
+ch_t* ch_build(graph_t* g);
+
+void ch_destroy(ch_t* ch);
+
+/**
+ * @brief Create a query context for a hierarchy, which must outlive it
+ *
+ * @param ch pointer to hierarchy
+ * @return ch_query_t*
+ */
+ch_query_t* ch_query_create(const ch_t* ch);
+
+void ch_query_destroy(ch_query_t* q);
+
+/**
+ * @brief Shortest path query: Dijkstra upward from src and upward from dst in the
+ *        downward graph, each stopping once its queue minimum reaches the best cost
+ *        seen where they meet. Vertices reached more cheaply from above are not
+ *        expanded (stall-on-demand). Shortcuts on the path are unpacked into original edges
+ *
+ * @param q pointer to query context
+ * @param src source node
+ * @param dst destination node
+ * @param path if not NULL, receives the vertices from src to dst (path->v must be freed),
+ *        or an empty path if dst is unreachable
+ * @return cost of the shortest path, INT_MAX if dst is unreachable
+ */
+int ch_query(ch_query_t* q, int src, int dst, path_t* path);
+
+/**
+ * @brief Write a hierarchy to a file, in the byte order of the machine
+ *
+ * @param ch pointer to hierarchy
+ * @param file path of the file
+ * @return true on success, false if the file could not be written
+ */
+bool ch_save(const ch_t* ch, const char* file);
+
+/**
+ * @brief Read a hierarchy written by ch_save. The file is checked in full, so that
+ *        queries on a loaded hierarchy stay in bounds: offsets in order from 0 to 
+ *        the edge count, targets and bypassed vertices in range and on the right side 
+ *        of the hierarchy, non-negative weights, the two edges of every shortcut 
+ *        present, and rank a permutation. A hierarchy of 0 vertices loads as well
+ *
+ * @param file path of the file
+ * @return ch_t*, NULL if the file could not be read or breaks any of these rules
+ */
+ch_t* ch_load(const char* file);
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @file    csr.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _CSR_H_
+#define _CSR_H_
+
+#include <stdbool.h>
+#include "graphs.h"
+
+// direction-optimizing BFS goes bottom-up when the frontier has more than 1/BFS_ALPHA of the unexplored edges
+#define BFS_ALPHA       15
+
+// and back top-down when the shrinking frontier has less than 1/BFS_BETA of the vertices
+#define BFS_BETA        18
+
+/**
+ * @brief Edge of an edge list
+ *
+ */
+typedef struct edge_s
+{
+    int u;                  // source vertex
+    int v;                  // destination vertex
+    int w;                  // edge weight
+
+}edge_t;
+
+/**
+ * @brief Compressed Sparse Row representation of a graph.
+ *        The edges leaving u are target[offset[u] .. offset[u+1]-1],
+ *        with their weights at the same positions of weight.
+ *        An edge takes 8 bytes, and the edges of a vertex are contiguous
+ *
+ */
+typedef struct csr_graph_s
+{
+    int     nv;             // number of vertices
+    int     ne;             // number of stored edges, twice the edges given for undirected graphs
+    bool    dir;            // direction flag
+    int*    offset;         // nv + 1 offsets into target and weight
+    int*    target;         // successor vertex of each edge
+    int*    weight;         // weight of each edge
+
+}csr_graph_t;
+
+
+/**
+ * @brief Build a CSR graph with the same edges as an adjacency list graph
+ *
+ * @param g pointer to graph
+ * @return csr_graph_t*
+ */
+csr_graph_t* csr_from_graph(graph_t* g);
+
+/**
+ * @brief Build a CSR graph from an edge list, bucketing the edges by source
+ *        with a counting sort in O(V + E)
+ *
+ * @param nv number of vertices
+ * @param dir direction flag (true if graph is directed). If false, every edge is stored both ways
+ * @param edges array of edges
+ * @param ne number of edges
+ * @return csr_graph_t*
+ */
+csr_graph_t* csr_from_edges(int nv, bool dir, const edge_t* edges, int ne);
+
+/**
+ * @brief Build the transpose of a CSR graph, where each edge u -> v becomes v -> u.
+ *        Its edges out of v are the edges into v of the original graph
+ *
+ * @param g pointer to graph
+ * @return csr_graph_t*
+ */
+csr_graph_t* csr_transpose(csr_graph_t* g);
+
+void csr_destroy(csr_graph_t* g);
+
+/**
+ * @brief Solves single source shortest path problem on an unweighted CSR graph
+ *
+ * @param g pointer to graph
+ * @param src source node
+ * @return sssp_t*
+ */
+sssp_t* csr_bfs(csr_graph_t* g, int src);
+
+/**
+ * @brief Direction-optimizing BFS (Beamer). Small frontiers expand top-down over 
+ *        out-edges. Once the frontier gets large, each unvisited vertex instead scans its 
+ *        in-edges for a parent in the frontier and stops at the first hit, 
+ *        which skips most edges on low-diameter graphs. Frontier and visited 
+ *        sets are bitmaps on the heap
+ *
+ * @param g pointer to graph
+ * @param in transpose of g from csr_transpose, or NULL. A directed graph without it 
+ *        is transposed internally on the first bottom-up step, so pass it when running 
+ *        several searches
+ * @param src source node
+ * @return sssp_t*
+ */
+sssp_t* csr_bfs_do(csr_graph_t* g, csr_graph_t* in, int src);
+
+/**
+ * @brief Level-synchronous BFS on a pool of threads. Each level's frontier is 
+ *        split in blocks; a vertex is claimed by the first thread to CAS its parent 
+ *        from -1, and each block collects its claims in a local buffer. The buffers 
+ *        are then concatenated into the next frontier at offsets given by a prefix sum
+ *
+ * @param g pointer to graph
+ * @param src source node
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ * @return sssp_t*, from csr_bfs if the thread pool cannot be created
+ */
+sssp_t* csr_parallel_bfs(csr_graph_t* g, int src, int nthreads);
+
+/**
+ * @brief Dijkstra's algorithm on a positively weighted CSR graph, with a d-ary heap
+ *
+ * @param g pointer to graph
+ * @param src source node
+ * @return sssp_t*
+ */
+sssp_t* csr_dijkstra(csr_graph_t* g, int src);
+
+/**
+ * @brief Bellman-Ford's algorithm on a weighted CSR graph. Passes stop early once
+ *        no cost changes
+ *
+ * @param g pointer to graph
+ * @param src source node
+ * @return An sssp object if no negative cycles are found, NULL if a negative cycle is found
+ */
+sssp_t* csr_bellman_ford(csr_graph_t* g, int src);
+
+#endif
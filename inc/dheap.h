@@ -0,0 +1,82 @@
+/**
+ * @file    dheap.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _DHEAP_H_
+#define _DHEAP_H_
+
+#include <stdbool.h>
+#include "heap.h"
+
+/**
+ * @brief Indexed d-ary min heap with priorities and keys in separate arrays.
+ *        Priorities are cache-line aligned and shifted so that the d children 
+ *        of a node share one cache line and can be compared with a single SIMD min
+ * 
+ */
+typedef struct dheap_s
+{
+    int*    prio;           // priority of each slot, slot j stored at prio[j + d - 1]
+    int*    key;            // key of each slot
+    int*    pos;            // slot of each key, -1 if absent
+    int     size;           // capacity, keys must be in [0,size)
+    int     ctr;            // number of items
+    int     d;              // arity
+
+    int     (*min_child)(const int* p);     // index of the smallest of d priorities
+
+}dheap_t;
+
+/**
+ * @brief Create an indexed d-ary min heap
+ * 
+ * @param size heap capacity, keys must be in [0,size)
+ * @param d arity: 2, 4, 8 or 16. 4 and 8 compare children with SIMD
+ * @return dheap_t* NULL if d is not supported
+ */
+dheap_t* dheap_create(int size, int d);
+
+void dheap_destroy(dheap_t* heap);
+
+/**
+ * @brief Insert a key with priority v in O(log_d n)
+ *
+ * @return true on success, false if k is outside [0,size) or already in the heap
+ */
+bool dheap_insert(dheap_t* heap, int k, int v);
+
+/**
+ * @brief Lower the priority of key k to v in O(log_d n)
+ */
+void dheap_decrease_key(dheap_t* heap, int k, int v);
+
+/**
+ * @brief Item with smallest priority in O(1), left in the heap
+ * 
+ * @param heap pointer to heap
+ * @param pair returns the item
+ * @return 1 if there is an item, 0 if the heap is empty 
+ */
+int dheap_min(const dheap_t* heap, key_value_t* pair);
+
+/**
+ * @brief Remove the item with smallest priority in O(d log_d n)
+ * 
+ * @param heap pointer to heap
+ * @param pair returns the removed item
+ * @return 1 if an item was removed, 0 if the heap is empty 
+ */
+int dheap_extract_min(dheap_t* heap, key_value_t* pair);
+
+bool dheap_contains(dheap_t* heap, int k);
+
+/**
+ * @brief Remove every item in O(number of items), so that a heap over many keys 
+ *        can be reused by searches that only queue a few of them
+ */
+void dheap_clear(dheap_t* heap);
+
+#endif
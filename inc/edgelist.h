@@ -0,0 +1,58 @@
+/**
+ * @file    edgelist.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _EDGELIST_H_
+#define _EDGELIST_H_
+
+#include "graphs.h"
+
+/**
+ * @brief Edge list as a structure of arrays, sorted by destination.
+ *        Edge i goes from src[i] to dst[i] with weight weight[i], and the
+ *        edges into v are first[v] .. first[v+1]-1, so a range of
+ *        destinations is a range of edges
+ *
+ */
+typedef struct edge_list_s
+{
+    int     nv;             // number of vertices
+    int     ne;             // number of edges, twice the edges added for undirected graphs
+    int*    first;          // nv + 1 offsets into src, dst and weight
+    int*    src;            // source vertex of each edge
+    int*    dst;            // destination vertex of each edge
+    int*    weight;         // weight of each edge
+
+}edge_list_t;
+
+
+/**
+ * @brief Build an edge list with the same edges as an adjacency list graph,
+ *        bucketing them by destination with a counting sort in O(V + E)
+ *
+ * @param g pointer to graph
+ * @return edge_list_t*
+ */
+edge_list_t* edge_list_from_graph(graph_t* g);
+
+void edge_list_destroy(edge_list_t* el);
+
+/**
+ * @brief Bellman-Ford's algorithm on an edge list. Each pass reads the costs of
+ *        the previous pass and writes new ones, and threads own ranges of
+ *        destinations with about the same number of edges, so no two threads write
+ *        the same vertex. Edges are relaxed 8 at a time with AVX2 gathers and
+ *        compares when the CPU has them, and only the improving ones are written.
+ *        Passes stop early once no cost changes
+ *
+ * @param el pointer to edge list
+ * @param src source node
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ * @return An sssp object if no negative cycles are found, NULL if a negative cycle is found
+ */
+sssp_t* edge_list_bellman_ford(edge_list_t* el, int src, int nthreads);
+
+#endif
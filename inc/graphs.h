@@ -17,6 +17,19 @@
 #define USE_BFS             0
 #define USE_DIJKSTRA        1
 #define USE_BELLMAN_FORD    2
+#define USE_DELTA_STEPPING  3
+#define USE_SPFA            4
+
+#define PQ_BINARY_HEAP      0
+#define PQ_DARY_HEAP        1
+#define PQ_RADIX_HEAP       2
+#define PQ_BUCKET_QUEUE     3
+
+// arity of the PQ_DARY_HEAP priority queue
+#define DARY_HEAP_ARITY     8
+
+// largest edge weight handled by PQ_BUCKET_QUEUE, heavier graphs use PQ_RADIX_HEAP
+#define BUCKET_QUEUE_MAX_WEIGHT     (1 << 16)
 
 
 /**
@@ -29,6 +42,17 @@ struct node{
     struct node* next;      // next edge on linked list of adjacencies       
 };
 
+/**
+ * @brief Block of adjacency nodes handed out in order by the graph arena
+ * 
+ */
+struct node_chunk{
+    struct node_chunk* next;    // previously allocated chunk
+    int used;                   // nodes handed out so far
+    int cap;                    // number of nodes in the chunk
+    struct node nodes[];
+};
+
 /**
  * @brief Adjacency list representation of graph
  * 
@@ -37,6 +61,9 @@ typedef struct graph_s{
     int nv;                 // number of vertices       
     bool dir;               // direction flag          
     struct node** adj;      // array of adjacency linked lists  
+
+    struct node_chunk* chunks;  // arena holding every node of the graph
+    struct node* free_nodes;    // nodes released by remove_edge, linked by next
 }graph_t;
 
 
@@ -50,9 +77,9 @@ typedef struct graph_s{
 graph_t* create_graph(int nv, bool dir);
 
 /**
- * @brief 
+ * @brief Destroy a graph, releasing its nodes in bulk with the arena
  * 
- * @param g 
+ * @param g pointer to graph
  */
 void destroy_graph(graph_t* g);
 
@@ -68,6 +95,18 @@ void destroy_graph(graph_t* g);
  */
 void add_edge(graph_t* g, int src, int dst, int w);
 
+/**
+ * @brief Remove an edge from a graph. 
+ * If graph is not directed this function will
+ * also remove the edge from dst to src. The nodes are kept for reuse by add_edge.
+ * 
+ * @param g pointer to graph
+ * @param src source vertex
+ * @param dst destination vertex
+ * @return true if an edge was removed, false if there was no edge from src to dst
+ */
+bool remove_edge(graph_t* g, int src, int dst);
+
 /**
  * @brief Add a vertex to a graph
  * 
@@ -75,6 +114,15 @@ void add_edge(graph_t* g, int src, int dst, int w);
  */
 void add_vertex(graph_t* g);
 
+/**
+ * @brief Build the transpose of a graph, where each edge u -> v becomes v -> u.
+ * Its adjacency list of v holds the edges into v of the original graph
+ * 
+ * @param g pointer to graph
+ * @return graph_t* 
+ */
+graph_t* transpose_graph(graph_t* g);
+
 /**
  * @brief Print a graph in adjacency list representation
  * 
@@ -96,6 +144,17 @@ typedef struct sssp_s
 
 }sssp_t;
 
+/**
+ * @brief Sequence of vertices, such as a cycle found by spfa
+ * 
+ */
+typedef struct path_s
+{
+     int* v;      /* Vertices in order. For a cycle the last one has an edge back to the first*/
+     int  n;      /* Number of vertices*/
+
+}path_t;
+
 /**
  * @brief Solves single source shortest path problem on an unweighted directed graph
  * 
@@ -116,10 +175,24 @@ sssp_t* bfs(graph_t* g, int src);
  */
 sssp_t* dijkstra(graph_t* g, int src);
 
+/**
+ * @brief Dijkstra's algorithm with a choice of priority queue
+ * 
+ * @param g pointer to graph
+ * @param src source node
+ * @param pq priority queue to use. Options: PQ_BINARY_HEAP, PQ_DARY_HEAP, 
+ *        PQ_RADIX_HEAP and PQ_BUCKET_QUEUE. The last two are monotone queues 
+ *        for non-negative integer weights, O(E + V log C) and O(E + V*C) for a 
+ *        largest weight C
+ * @return sssp_t*, NULL if the queue rejected a vertex, as PQ_RADIX_HEAP and 
+ *         PQ_BUCKET_QUEUE do with negative weights, or could not grow
+ */
+sssp_t* dijkstra_with(graph_t* g, int src, int pq);
+
 
 /**
  * @brief Finds the shortest path from node src to node dst in a weighted directed graph
- * using Bellman-Ford's algorithm
+ * using Bellman-Ford's algorithm. Passes stop early once no cost changes
  * 
  * @param g pointer to graph
  * @param src source node
@@ -127,14 +200,46 @@ sssp_t* dijkstra(graph_t* g, int src);
  */
 sssp_t* bellman_ford(graph_t* g, int src);
 
+/**
+ * @brief Queue-based Bellman-Ford (SPFA) with Tarjan's subtree disassembly.
+ * Only the edges out of vertices whose cost changed are relaxed. When the cost of
+ * a vertex drops, its subtree in the shortest path tree is taken out of the tree and
+ * its queued vertices are skipped, since their costs will drop again. A relaxation
+ * from inside the subtree of its own target closes a negative cycle, which is 
+ * reported as soon as it appears instead of after V passes
+ * 
+ * @param g pointer to graph
+ * @param src source node
+ * @param cycle if not NULL, receives the negative cycle when one is found (cycle->v must be freed), 
+ *        or an empty path otherwise
+ * @return An sssp object if no negative cycles are found, NULL if a negative cycle is found 
+ */
+sssp_t* spfa(graph_t* g, int src, path_t* cycle);
+
+/**
+ * @brief Finds the shortest paths from node src in a graph with non-negative weights
+ * using parallel delta-stepping. Vertices are kept in buckets of width delta; within 
+ * a bucket the light edges (w <= delta) are relaxed in parallel until it stays empty, 
+ * then the heavy edges of the vertices settled in it are relaxed once
+ * 
+ * @param g pointer to graph
+ * @param src source node
+ * @param delta bucket width, or <= 0 for the largest weight over the average degree
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ * @return sssp_t*, NULL if the thread pool cannot be created
+ */
+sssp_t* delta_stepping(graph_t* g, int src, int delta, int nthreads);
+
 /**
  * @brief Prints the shortest path between two nodes in a graph
  * 
  * @param g pointer to graph
  * @param src source node
  * @param dst destination node
- * @param algo algorithm to use. Options: USE_BFS (only unweighted graphs), USE_DIJKSTRA, USE_BELLMAN_FORD
-
+ * @param algo algorithm to use. Options: USE_BFS (only unweighted graphs), USE_DIJKSTRA, USE_BELLMAN_FORD,
+ *        USE_DELTA_STEPPING (non-negative weights), USE_SPFA. USE_DIJKSTRA stops once dst is settled,
+ *        the others build the whole shortest path tree from src; for repeated point-to-point
+ *        queries reuse a p2p_t from p2p.h instead
  * @return TRUE if successful, FALSE if failed
  */
 bool shortest_path(graph_t* g, int src , int dst, int algo);
@@ -9,6 +9,7 @@
 #define _HEAP_H_
 
 #include <stdlib.h>
+#include <stdbool.h>
 
 #define MIN_HEAP 0
 #define MAX_HEAP 1
@@ -24,22 +25,142 @@ typedef struct key_value_s
 typedef struct heap_s
 {
     key_value_t *pair;
-    int         size; 
+    int         size;       // capacity, doubled when full
     int         ctr;
+    int         type;       // MIN_HEAP or MAX_HEAP
+    int         *pos;       // slot of each key, -1 if absent. NULL if the heap is not indexed
+    int         nkeys;      // length of pos
 
 }heap_t;
 
 
+/**
+ * @brief Create an empty heap
+ * 
+ * @param size initial capacity, the heap grows as needed
+ * @param type MIN_HEAP or MAX_HEAP
+ * @return heap_t*, NULL if the memory could not be allocated
+ */
+heap_t* heap_create(int size, int type);
+
 heap_t* min_heap(int size);
 
+heap_t* max_heap(int size);
+
+/**
+ * @brief Create a min heap indexed by key. A position map from key to heap slot 
+ *        is kept up to date on every move, so decrease-key, contains and delete 
+ *        run in O(logn) instead of scanning the heap
+ * 
+ * @param size initial capacity, keys are expected in [0,size) but the map grows for bigger keys
+ * @return heap_t*, NULL if the memory could not be allocated
+ */
+heap_t* indexed_min_heap(int size);
+
+/**
+ * @brief Build a heap from an array of pairs in O(n)
+ * 
+ * @param pairs array of pairs, copied to the heap
+ * @param n number of pairs
+ * @param type MIN_HEAP or MAX_HEAP
+ * @return heap_t*, NULL if the memory could not be allocated
+ */
+heap_t* heap_build(const key_value_t* pairs, int n, int type);
+
+void destroy_heap(heap_t* heap);
+
+/*
+ * The min_* operations work on MIN_HEAP heaps and the max_* operations on 
+ * MAX_HEAP heaps. On a heap of the other type they leave it untouched: 
+ * inserts return false and extracts return 0
+ */
+
 void min_heapify(heap_t* heap,int i);
 
-void min_insert(heap_t* heap, int k, int v);
+void max_heapify(heap_t* heap,int i);
+
+/**
+ * @brief Insert key k with value v
+ * 
+ * @param heap pointer to min heap
+ * @param k key, not negative if the heap is indexed
+ * @param v value
+ * @return false if the heap is not a min heap, k was rejected or the heap 
+ *         could not grow, the heap is left as it was
+ */
+bool min_insert(heap_t* heap, int k, int v);
+
+bool max_insert(heap_t* heap, int k, int v);
 
 void min_decrease_key(heap_t* heap, int k, int v);
 
+void max_increase_key(heap_t* heap, int k, int v);
+
 int extract_min(heap_t* heap, key_value_t* pair);
 
+int extract_max(heap_t* heap, key_value_t* pair);
+
+bool heap_contains(heap_t* heap, int k);
+
+/**
+ * @brief Remove the pair with key k from the heap, wherever it is
+ * 
+ * @param heap pointer to heap
+ * @param k key to remove
+ * @return 1 if the key was removed, 0 if it was not in the heap 
+ */
+int heap_delete(heap_t* heap, int k);
+
+/**
+ * @brief Move every pair of heap b into heap a, leaving b empty. 
+ *        O(m log(n+m)) for a small b, O(n+m) otherwise
+ * 
+ * @param a pointer to heap that receives the pairs
+ * @param b pointer to heap of the same type. If a is indexed, keys must not be in both heaps
+ * @return false if a could not grow or b has a negative key for an indexed a, both heaps are left as they were
+ */
+bool heap_meld(heap_t* a, heap_t* b);
+
+/**
+ * @brief Streaming selection of the k items with smallest value, 
+ *        kept in a max heap bounded to k items
+ * 
+ */
+typedef struct topk_s
+{
+    heap_t* heap;
+    int     k;
+
+}topk_t;
+
+/**
+ * @brief Create a streaming selection of the k items with smallest value
+ * 
+ * @param k number of items to keep
+ * @return topk_t* 
+ */
+topk_t* topk_create(int k);
+
+void topk_destroy(topk_t* t);
+
+/**
+ * @brief Offer an item to the selection in O(logk)
+ * 
+ * @param t pointer to selection
+ * @param k item key
+ * @param v item value
+ */
+void topk_push(topk_t* t, int k, int v);
+
+/**
+ * @brief Copy the items kept so far to out, in ascending order of value
+ * 
+ * @param t pointer to selection
+ * @param out array of at least k pairs
+ * @return number of items written
+ */
+int topk_result(topk_t* t, key_value_t* out);
+
 void test_min_heap();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file    monoqueue.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ * Monotone priority queues for non-negative integer priorities. Extracted
+ * priorities never decrease, and no item may be inserted below the last
+ * extracted priority, which is exactly how Dijkstra's algorithm uses its queue.
+ * Neither queue has decrease-key: a lower priority is inserted as a duplicate
+ * and the caller skips stale items when they come out.
+ */
+#ifndef _MONOQUEUE_H_
+#define _MONOQUEUE_H_
+
+#include "heap.h"
+
+/**
+ * @brief Growable array of items
+ *
+ */
+typedef struct kv_bucket_s
+{
+    key_value_t*    items;
+    int             n;
+    int             cap;
+
+}kv_bucket_t;
+
+/**
+ * @brief Radix heap. Bucket i holds the items whose priority first differs
+ *        from the last extracted one at bit i-1, so each item moves down at
+ *        most 32 buckets over its lifetime
+ *
+ */
+typedef struct rheap_s
+{
+    kv_bucket_t     bucket[33];
+    unsigned        last;           // last extracted priority
+    int             ctr;            // number of items
+
+}rheap_t;
+
+/**
+ * @brief Dial's bucket queue. While the smallest priority is cur, every
+ *        priority lies in [cur, cur + C] for a maximum edge weight C, so C+1
+ *        buckets used as a circular array hold them all
+ *
+ */
+typedef struct bucketq_s
+{
+    kv_bucket_t*    bucket;
+    int             nb;             // number of buckets, C + 1
+    int             cur;            // smallest priority that may still be queued
+    int             idx;            // bucket of cur
+    int             ctr;            // number of items
+
+}bucketq_t;
+
+
+rheap_t* rheap_create(void);
+
+void rheap_destroy(rheap_t* heap);
+
+/**
+ * @brief Insert key k with priority v in O(1)
+ *
+ * @return true on success, false if v is negative or below the last extracted priority
+ */
+bool rheap_insert(rheap_t* heap, int k, int v);
+
+/**
+ * @brief Remove an item with smallest priority, O(log C) amortized
+ *
+ * @param heap pointer to heap
+ * @param pair returns the removed item
+ * @return 1 if an item was removed, 0 if the heap is empty
+ */
+int rheap_extract_min(rheap_t* heap, key_value_t* pair);
+
+
+/**
+ * @brief Create a bucket queue
+ *
+ * @param max_weight largest difference between a queued priority and the smallest one
+ * @return bucketq_t*
+ */
+bucketq_t* bucketq_create(int max_weight);
+
+void bucketq_destroy(bucketq_t* q);
+
+/**
+ * @brief Insert key k with priority v in O(1)
+ *
+ * @return 1 on success, 0 if v is outside [cur, cur + max_weight]
+ */
+int bucketq_insert(bucketq_t* q, int k, int v);
+
+/**
+ * @brief Remove an item with smallest priority. The scan over empty buckets
+ *        costs O(largest priority) over all calls, so a Dijkstra run is O(E + V*C)
+ *
+ * @param q pointer to queue
+ * @param pair returns the removed item
+ * @return 1 if an item was removed, 0 if the queue is empty
+ */
+int bucketq_extract_min(bucketq_t* q, key_value_t* pair);
+
+#endif
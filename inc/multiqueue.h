@@ -0,0 +1,71 @@
+/**
+ * @file    multiqueue.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _MULTIQUEUE_H_
+#define _MULTIQUEUE_H_
+
+#include <stdatomic.h>
+#include "heap.h"
+
+// heaps per thread
+#define MULTIQUEUE_C    2
+
+/**
+ * @brief Sequential heap behind a try-lock, alone on its cache line
+ *
+ */
+typedef struct mq_heap_s
+{
+    _Alignas(64)
+    atomic_int  lock;           // 1 while a thread owns the heap
+    atomic_int  top;            // value on the root, read without the lock
+    atomic_int  ctr;            // number of items, read without the lock
+    heap_t*     heap;
+
+}mq_heap_t;
+
+/**
+ * @brief Concurrent relaxed min priority queue (MultiQueue).
+ *        Items are spread over c*T heaps: insert picks a random heap,
+ *        extract takes the smaller root of two random heaps.
+ *        An extracted item is not always the global minimum, but it is
+ *        close to it in rank, and threads rarely wait on each other
+ *
+ */
+typedef struct multiqueue_s
+{
+    mq_heap_t*  q;
+    int         nq;             // number of heaps
+
+}multiqueue_t;
+
+/**
+ * @brief Create a MultiQueue
+ *
+ * @param nthreads number of threads that will use it, or <= 0 for all online CPUs
+ * @param c heaps per thread, or <= 0 for MULTIQUEUE_C
+ * @return multiqueue_t*
+ */
+multiqueue_t* multiqueue_create(int nthreads, int c);
+
+void multiqueue_destroy(multiqueue_t* mq);
+
+/**
+ * @brief Insert key k with priority v. Safe to call from any thread
+ */
+void multiqueue_insert(multiqueue_t* mq, int k, int v);
+
+/**
+ * @brief Remove an item with small priority. Safe to call from any thread
+ *
+ * @param mq pointer to queue
+ * @param pair returns the removed item
+ * @return 1 if an item was removed, 0 if every heap was found empty
+ */
+int multiqueue_extract_min(multiqueue_t* mq, key_value_t* pair);
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file    p2p.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _P2P_H_
+#define _P2P_H_
+
+#include "graphs.h"
+#include "heap.h"
+
+/**
+ * @brief Lower bound on the cost of the path from v to dst. It must never
+ *        overestimate, or A* may return a longer path
+ *
+ */
+typedef int (*heuristic_fn)(int v, int dst, void* ctx);
+
+/**
+ * @brief Vertex coordinates for p2p_euclidean
+ *
+ */
+typedef struct p2p_coords_s
+{
+    const double*   x;
+    const double*   y;
+    double          scale;      // least edge weight per unit of distance
+
+}p2p_coords_t;
+
+/**
+ * @brief Point-to-point shortest path queries on a graph. Costs and parents are
+ *        valid only where a vertex's stamp matches the current query, so a query
+ *        touches just the vertices it reaches instead of resetting all of them
+ *
+ */
+typedef struct p2p_s
+{
+    graph_t*    g;              // graph searched forward from src
+    graph_t*    rev;            // graph searched backward from dst, g itself if undirected. NULL until
+                                // the first bidirectional query on a directed g
+    unsigned    query;          // stamp of the current query
+
+    unsigned*   seen[2];        // stamp of the query that reached each vertex, forward and backward
+    int*        cost[2];
+    int*        prev[2];        // backward, the next vertex towards dst
+    int*        est;            // A* heuristic of each reached vertex
+    heap_t*     q[2];
+
+    int         touched;        // vertices reached by the last query
+
+}p2p_t;
+
+
+/**
+ * @brief Create a query context for a graph with non-negative weights. A directed
+ *        graph is transposed once, on the first p2p_bidirectional query, for the 
+ *        backward searches; the graph must not change while the context is in use
+ *
+ * @param g pointer to graph
+ * @return p2p_t*
+ */
+p2p_t* p2p_create(graph_t* g);
+
+void p2p_destroy(p2p_t* p);
+
+/**
+ * @brief Dijkstra's algorithm from src that stops as soon as dst is settled
+ *
+ * @param p pointer to query context
+ * @param src source node
+ * @param dst destination node
+ * @param path if not NULL, receives the vertices from src to dst (path->v must be freed),
+ *        or an empty path if dst is unreachable
+ * @return cost of the shortest path, INT_MAX if dst is unreachable
+ */
+int p2p_dijkstra(p2p_t* p, int src, int dst, path_t* path);
+
+/**
+ * @brief Bidirectional Dijkstra: one search forward from src and one backward from
+ *        dst, always advancing the one with the smaller queue. Stops once the two
+ *        queue minimums add up to at least the best src-dst cost seen where the
+ *        searches meet
+ *
+ * @param p pointer to query context
+ * @param src source node
+ * @param dst destination node
+ * @param path if not NULL, receives the vertices from src to dst (path->v must be freed),
+ *        or an empty path if dst is unreachable
+ * @return cost of the shortest path, INT_MAX if dst is unreachable
+ */
+int p2p_bidirectional(p2p_t* p, int src, int dst, path_t* path);
+
+/**
+ * @brief A* search: Dijkstra ordered by cost plus an estimate of the remaining cost,
+ *        so vertices leading away from dst are expanded late or never. Stops when
+ *        dst is settled
+ *
+ * @param p pointer to query context
+ * @param src source node
+ * @param dst destination node
+ * @param h admissible heuristic, or NULL for plain Dijkstra
+ * @param ctx passed to h
+ * @param path if not NULL, receives the vertices from src to dst (path->v must be freed),
+ *        or an empty path if dst is unreachable
+ * @return cost of the shortest path, INT_MAX if dst is unreachable
+ */
+int p2p_astar(p2p_t* p, int src, int dst, heuristic_fn h, void* ctx, path_t* path);
+
+/**
+ * @brief Straight-line distance from v to dst times coords->scale, rounded down.
+ *        Admissible when no edge is cheaper than scale per unit of distance
+ *
+ * @param ctx pointer to p2p_coords_t
+ */
+int p2p_euclidean(int v, int dst, void* ctx);
+
+#endif
@@ -9,74 +9,184 @@
 #define _QUEUE_H_
 
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
 
+#define CACHE_LINE_SIZE 64
 
+
+/**
+ * @brief FIFO queue of ints on a ring buffer, for a single thread.
+ *        The capacity is a power of two and doubles when the queue is full
+ *
+ */
 typedef struct queue_s
 {
-    int size;
+    int size;               // capacity, a power of two
     int tail;
     int head;
-    int ctr;
+    int ctr;                // number of items
 
     int* ptr;
 }queue_t;
 
-
-void queue(queue_t* q, int size)
+/**
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread.
+ *        Each side owns one index and keeps a cached copy of the other one,
+ *        on separate cache lines, so the threads only share a line when the
+ *        cached copy runs out
+ *
+ */
+typedef struct spsc_s
 {
-    if(q == NULL)
-        return;
+    _Alignas(CACHE_LINE_SIZE)
+    atomic_size_t   tail;           // next slot to write, written by the producer
+    size_t          head_cache;     // producer's copy of head
+
+    _Alignas(CACHE_LINE_SIZE)
+    atomic_size_t   head;           // next slot to read, written by the consumer
+    size_t          tail_cache;     // consumer's copy of tail
 
-    q->ctr = 0;
-    q->size = size;
-    q->head = 0;
-    q->tail = 0;
+    _Alignas(CACHE_LINE_SIZE)
+    int*            ptr;
+    size_t          mask;           // capacity - 1
 
-    q->ptr = (int*)malloc(size * sizeof(int));
-}
+}spsc_t;
 
-void queue_delete(queue_t* q)
+/**
+ * @brief Slot of an MPMC queue. Its sequence number tells whose turn it is:
+ *        pos when free for the producer of position pos, pos+1 when full for its consumer
+ *
+ */
+typedef struct mpmc_cell_s
 {
-    if(q == NULL)
-        return;
+    atomic_size_t   seq;
+    int             data;
 
-    free(q->ptr);
-}
+}mpmc_cell_t;
 
-void enqueue(queue_t* q, int in)
+/**
+ * @brief Bounded lock-free queue for any number of producers and consumers
+ *        (Vyukov). Threads claim positions with a CAS on enqueue_pos or
+ *        dequeue_pos and then hand the cell over through its sequence number
+ *
+ */
+typedef struct mpmc_s
 {
-    if(q == NULL)
-        return;
+    _Alignas(CACHE_LINE_SIZE)
+    atomic_size_t   enqueue_pos;
 
-    if(q->ctr == q->size)
-        return;
+    _Alignas(CACHE_LINE_SIZE)
+    atomic_size_t   dequeue_pos;
 
-    q->ptr[q->tail] = in;
+    _Alignas(CACHE_LINE_SIZE)
+    mpmc_cell_t*    cells;
+    size_t          mask;           // capacity - 1
 
-    q->ctr++;
+}mpmc_t;
 
-    q->tail = (q->tail + 1) % q->size;
 
-}
+/**
+ * @brief Initialize a queue
+ *
+ * @param q pointer to queue
+ * @param size initial capacity, rounded up to a power of two
+ * @return true on success, false if memory could not be allocated
+ */
+bool queue(queue_t* q, int size);
 
-void dequeue(queue_t* q, int* out)
-{
-    if(q == NULL)
-        return;
+void queue_delete(queue_t* q);
+
+/**
+ * @brief Add an item at the tail, growing the queue if it is full
+ *
+ * @return true on success, false if the queue is full and could not grow
+ */
+bool enqueue(queue_t* q, int in);
+
+/**
+ * @brief Remove the item at the head
+ *
+ * @return true on success, false if the queue is empty
+ */
+bool dequeue(queue_t* q, int* out);
+
+
+/**
+ * @brief Create an SPSC queue
+ *
+ * @param size capacity, rounded up to a power of two
+ * @return spsc_t*
+ */
+spsc_t* spsc_create(size_t size);
+
+void spsc_destroy(spsc_t* q);
 
-    if(out == NULL)
-        return;   
+/**
+ * @brief Add an item. Producer thread only
+ *
+ * @return true on success, false if the queue is full
+ */
+bool spsc_enqueue(spsc_t* q, int in);
 
-    if(!q->ctr)
-        return;
-     
-     q->ctr--;
+/**
+ * @brief Remove an item. Consumer thread only
+ *
+ * @return true on success, false if the queue is empty
+ */
+bool spsc_dequeue(spsc_t* q, int* out);
 
-     *out = q->ptr[q->head];
-     
-     q->head = (q->head + 1) % q->size;
+/**
+ * @brief Add up to n items with a single index update. Producer thread only
+ *
+ * @return number of items added
+ */
+size_t spsc_enqueue_batch(spsc_t* q, const int* in, size_t n);
 
+/**
+ * @brief Remove up to n items with a single index update. Consumer thread only
+ *
+ * @return number of items removed
+ */
+size_t spsc_dequeue_batch(spsc_t* q, int* out, size_t n);
+
+
+/**
+ * @brief Create an MPMC queue
+ *
+ * @param size capacity, rounded up to a power of two (at least 2)
+ * @return mpmc_t*
+ */
+mpmc_t* mpmc_create(size_t size);
 
-}
+void mpmc_destroy(mpmc_t* q);
+
+/**
+ * @brief Add an item. Safe to call from any thread
+ *
+ * @return true on success, false if the queue is full
+ */
+bool mpmc_enqueue(mpmc_t* q, int in);
+
+/**
+ * @brief Remove an item. Safe to call from any thread
+ *
+ * @return true on success, false if the queue is empty
+ */
+bool mpmc_dequeue(mpmc_t* q, int* out);
+
+/**
+ * @brief Add up to n items, claiming consecutive positions with a single CAS
+ *
+ * @return number of items added
+ */
+size_t mpmc_enqueue_batch(mpmc_t* q, const int* in, size_t n);
+
+/**
+ * @brief Remove up to n items, claiming consecutive positions with a single CAS
+ *
+ * @return number of items removed
+ */
+size_t mpmc_dequeue_batch(mpmc_t* q, int* out, size_t n);
 
-#endif
\ No newline at end of file
+#endif
@@ -10,9 +10,14 @@
 #define _SORT_H_
 
 #include <stdint.h>
+#include <stddef.h>
+#include "heap.h"
+
+#define PARTITION_THREE_WAY     0
+#define PARTITION_BLOCK         1
 
 /**
- * @brief Recursively sort an array in ascending order with Θ(nlogn) time complexity, where n = r-p+1 
+ * @brief Sort an array in ascending order with Θ(nlogn) time complexity, where n = r-p+1 
  * 
  * @param a array to be sorted
  * @param p first index of array to be sorted
@@ -21,8 +26,41 @@
 void mergesort(int* arr,int p,int r);
 
 /**
- * @brief Recursively sort an array in ascending order with Θ(nlogn) time complexity
- *        using a heap data structure
+ * @brief Iteratively sort an array in ascending order with Θ(nlogn) time complexity
+ *        using bottom-up merge passes that alternate between the array and a scratch buffer
+ * 
+ * @param a array to be sorted
+ * @param n size of the array
+ * @param buf scratch buffer of at least n elements, or NULL to allocate one internally;
+ *        if that allocation fails the array is sorted in place by quicksort()
+ */
+void bottomup_mergesort(int* a, int n, int* buf);
+
+/**
+ * @brief Sort an array in ascending order with mergesort on a pool of threads.
+ *        Chunks are sorted in parallel and every merge pass, including the last one, 
+ *        is split across threads along the merge path.
+ * 
+ * @param a array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ */
+void parallel_mergesort(int* a, int p, int r, int nthreads);
+
+/**
+ * @brief Sort an array in ascending order with an adaptive, run-detecting mergesort (timsort).
+ *        Existing ascending and strictly descending runs are used as they are, so 
+ *        already sorted input costs O(n) and the worst case is Θ(nlogn)
+ * 
+ * @param a pointer to array to be sorted
+ * @param n size of the array to be sorted
+ */
+void timsort(int* a, int n);
+
+/**
+ * @brief Sort an array in ascending order with Θ(nlogn) time complexity
+ *        and O(1) extra memory using a heap data structure
  * 
  * @param a pointer to array to be sorted
  * @param n size of the array to be sorted
@@ -30,12 +68,88 @@ void mergesort(int* arr,int p,int r);
 void heapsort(int* a, int n);
 
 
+/**
+ * @brief Sort an array in ascending order with worst case time complexity Θ(nlogn)
+ *        using introsort: median-of-three/ninther pivots, three-way partitioning, 
+ *        sorting networks for small ranges and heapsort when recursion gets too deep
+ * 
+ * @param a pointer to array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ */
+void quicksort(int* a, int p, int r);
+
+/**
+ * @brief Sort an array in ascending order with introsort using the given partition scheme
+ * 
+ * @param a pointer to array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param scheme PARTITION_THREE_WAY (best with many duplicate keys) or 
+ *               PARTITION_BLOCK (branchless, best with distinct keys)
+ */
+void quicksort_with(int* a, int p, int r, int scheme);
+
 /**
  * @brief Recursively sort an array in ascending order with 
  *        average time complexity Θ(nlogn) and worst case of Θ(n²)
+ *        using a randomly chosen pivot on each partition
  * 
+ * @param a pointer to array to be sorted
  * @param p first index of array to be sorted
  * @param r last index of array to be sorted
  */
-void quicksort(int* a, int p, int r);
+void randomized_quicksort(int* a, int p, int r);
+
+/**
+ * @brief Sort an array in ascending order with introsort, running the recursion 
+ *        on a pool of threads above a grain size
+ * 
+ * @param a pointer to array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ */
+void parallel_quicksort(int* a, int p, int r, int nthreads);
+
+/**
+ * @brief Rearrange an array so that a[k] is the element that would be there if the 
+ *        array were sorted, with a[0,...,k-1] <= a[k] <= a[k+1,...,n-1].
+ *        Uses introselect: random pivots with Θ(n) average time, falling back to 
+ *        median of medians for a Θ(n) worst case once too many partitions were needed
+ * 
+ * @param a pointer to array
+ * @param n size of the array
+ * @param k index to select, 0 <= k < n
+ */
+void select_nth(int* a, int n, int k);
+
+/**
+ * @brief Rearrange an array so that a[0,...,k-1] holds its k smallest elements 
+ *        in ascending order, in Θ(n + klogk) time. The order of the remaining 
+ *        elements is unspecified
+ * 
+ * @param a pointer to array
+ * @param n size of the array
+ * @param k number of elements to sort
+ */
+void partial_sort(int* a, int n, int k);
+
+/**
+ * @brief Sort an array of integers in ascending order with Θ(n) time complexity 
+ *        using LSD radix sort over 11-bit digits
+ * 
+ * @param a pointer to array to be sorted
+ * @param n size of the array to be sorted
+ */
+void radix_sort(int* a, size_t n);
+
+/**
+ * @brief Stable sort of an array of key-value pairs in ascending order of value 
+ *        with Θ(n) time complexity using LSD radix sort over 11-bit digits
+ * 
+ * @param a pointer to array of pairs to be sorted
+ * @param n size of the array to be sorted
+ */
+void radix_sort_kv(key_value_t* a, size_t n);
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * @file    sortnet.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _SORTNET_H_
+#define _SORTNET_H_
+
+// largest block sorted in registers by sortnet_sort()
+#define SORTNET_MAX     64
+
+#define SIMD_NONE       0
+#define SIMD_SSE41      1
+#define SIMD_AVX2       2
+
+/**
+ * @brief Best instruction set available on the running CPU
+ * 
+ * @return SIMD_AVX2, SIMD_SSE41 or SIMD_NONE 
+ */
+int simd_level(void);
+
+/**
+ * @brief Sort a small array in ascending order with a bitonic sorting network 
+ *        held in SIMD registers. The array is padded up to the next block of 
+ *        8, 16, 32 or 64 elements. Falls back to insertion sort on CPUs without SSE4.1
+ * 
+ * @param a pointer to array to be sorted
+ * @param n size of the array, at most SORTNET_MAX
+ */
+void sortnet_sort(int* a, int n);
+
+/**
+ * @brief Merge two ordered arrays into out using a bitonic merge network 
+ *        that outputs one SIMD register per step
+ * 
+ * @param x first ordered array
+ * @param nx size of x
+ * @param y second ordered array
+ * @param ny size of y
+ * @param out array of nx+ny elements to receive the merged result
+ */
+void sortnet_merge(const int* x, int nx, const int* y, int ny, int* out);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file    threadpool.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <stdbool.h>
+#include <pthread.h>
+
+typedef void (*task_fn_t)(void* arg);
+
+/**
+ * @brief A task waiting to be run by the pool
+ * 
+ */
+typedef struct task_s
+{
+    task_fn_t           fn;         // function to run
+    void*               arg;        // argument passed to fn
+    struct group_s*     group;      // group notified when the task finishes
+
+}task_t;
+
+/**
+ * @brief Set of tasks that can be waited for together
+ * 
+ */
+typedef struct group_s
+{
+    int pending;                    // submitted tasks not finished yet
+
+}group_t;
+
+/**
+ * @brief Pool of worker threads consuming a shared queue of tasks
+ * 
+ */
+typedef struct pool_s
+{
+    pthread_t*      threads;        // worker threads
+    int             nthreads;       // number of workers, including the calling thread
+    
+    task_t*         tasks;          // ring buffer of pending tasks
+    int             size;
+    int             head;
+    int             ctr;
+
+    bool            stop;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;           // signaled when a task is submitted or a group finishes
+
+}pool_t;
+
+/**
+ * @brief Create a pool of worker threads. The thread that waits on a group 
+ *        also runs tasks, so nthreads-1 threads are spawned.
+ * 
+ * @param nthreads total number of threads, or <= 0 to use all online CPUs
+ * @return pool_t*, NULL if it cannot be allocated
+ */
+pool_t* pool_create(int nthreads);
+
+/**
+ * @brief Stop the workers and release the pool
+ * 
+ * @param pool pointer to pool
+ */
+void pool_destroy(pool_t* pool);
+
+/**
+ * @brief Queue a task to be run by the pool. If the queue is full and cannot grow, 
+ *        the task is run at once by the calling thread
+ * 
+ * @param pool pointer to pool
+ * @param group group the task belongs to
+ * @param fn function to run
+ * @param arg argument passed to fn
+ */
+void pool_submit(pool_t* pool, group_t* group, task_fn_t fn, void* arg);
+
+/**
+ * @brief Wait until every task of a group has finished, 
+ *        running queued tasks in the meantime
+ * 
+ * @param pool pointer to pool
+ * @param group group to wait for
+ */
+void pool_wait(pool_t* pool, group_t* group);
+
+/**
+ * @brief Run fn over the range [0,n) split in blocks of at least grain iterations
+ *        and wait for all of them to finish. Runs fn(0, n, ctx) on the calling thread 
+ *        if the blocks cannot be allocated
+ * 
+ * @param pool pointer to pool
+ * @param n number of iterations
+ * @param grain minimum number of iterations per task
+ * @param fn function called with each block [lo,hi)
+ * @param ctx context passed to fn
+ */
+void pool_parallel_for(pool_t* pool, int n, int grain, void (*fn)(int lo, int hi, void* ctx), void* ctx);
+
+/**
+ * @brief Number of online CPUs
+ */
+int pool_cpus(void);
+
+#endif
@@ -1,22 +1,11 @@
-
 #include <stdio.h>
+#include <string.h>
 #include "inc/sort.h"
 #include "inc/matrix.h"
 #include "inc/majority.h"
 #include "inc/graphs.h"
 #include "inc/heap.h"
 
-#define NO_TEST             0
-#define MERGESORT_TEST      1
-#define HEAPSORT_TEST       2
-#define QUICKSORT_TEST      3
-
-#define DETERMINANT_TEST    4 
-#define MAJORITY_TEST       5
-#define GRAPH_TEST          6
-
-#define TEST GRAPH_TEST
-
 void print_array(int* arr, int size)
 {
     for (int i=0; i < size; i++)
@@ -26,54 +15,62 @@ void print_array(int* arr, int size)
      printf("\n");
 }
 
-int main ()
+int main (int argc, char** argv)
 {
+    //demo to run, see bench/bench.c for measurements
+    const char* test = (argc > 1) ? argv[1] : "graph";
 
     int array[] = {2,6,2,1,9,2,6,4,6,2,6,2,2,11,2,2,2};
     size_t n = sizeof(array)/sizeof(array[0]);
 
-#if (TEST == MERGESORT_TEST)
-    mergesort(array,0,n-1);
-    print_array(array, n);
-#endif
-
-#if (TEST == HEAPSORT_TEST)
-    heapsort(array,n);
-    print_array(array, n);
-#endif    
-
-#if (TEST == QUICKSORT_TEST)
-    quicksort(array,0,n-1);
-    print_array(array, n);
-#endif
-
-#if (TEST == DETERMINANT_TEST)
-    int matrix[] = {8,3,7,6,9,1,5,4,11}; 
-    float det = det_sq_matrix(matrix,3);
-    print_matrix(matrix,3,3);
-    printf("det = %f \n", det);
-#endif
-
-#if (TEST == MAJORITY_TEST)
-    int major = majority(array,0,n-1);
-        printf("%d is the majority\n", major);
-#endif
-
-#if (TEST == GRAPH_TEST)
-    graph_t* graph = create_graph(5, DIRECTED);
-    add_edge(graph, 0, 1, 1);
-    add_edge(graph, 0, 2, 4);
-    add_edge(graph, 1, 2, 6);
-    add_edge(graph, 2, 3, 5);
-    add_edge(graph, 3, 4, 2);
+    if(strcmp(test, "mergesort") == 0)
+    {
+        mergesort(array,0,n-1);
+        print_array(array, n);
+    }
+    else if(strcmp(test, "heapsort") == 0)
+    {
+        heapsort(array,n);
+        print_array(array, n);
+    }
+    else if(strcmp(test, "quicksort") == 0)
+    {
+        quicksort(array,0,n-1);
+        print_array(array, n);
+    }
+    else if(strcmp(test, "determinant") == 0)
+    {
+        int matrix[] = {8,3,7,6,9,1,5,4,11}; 
+        float det = det_sq_matrix(matrix,3);
+        print_matrix(matrix,3,3);
+        printf("det = %f \n", det);
+    }
+    else if(strcmp(test, "majority") == 0)
+    {
+        int major = majority(array,0,n-1);
+        printf("%d is the majority\n", array[major]);
+    }
+    else if(strcmp(test, "graph") == 0)
+    {
+        graph_t* graph = create_graph(5, DIRECTED);
+        add_edge(graph, 0, 1, 1);
+        add_edge(graph, 0, 2, 4);
+        add_edge(graph, 1, 2, 6);
+        add_edge(graph, 2, 3, 5);
+        add_edge(graph, 3, 4, 2);
 
-    if (shortest_path(graph, 0, 4, USE_DIJKSTRA) == false) //USE_BELLMAN_FORD USE_DIJKSTRA
+        if (shortest_path(graph, 0, 4, USE_DIJKSTRA) == false) //USE_BELLMAN_FORD USE_DIJKSTRA
+        {
+            printf("failed to find shortest path \n");
+        }
+        
+        destroy_graph(graph);
+    }
+    else
     {
-        printf("failed to find shortest path \n");
+        printf("usage: %s [mergesort|heapsort|quicksort|determinant|majority|graph]\n", argv[0]);
+        return 1;
     }
-    
-    destroy_graph(graph);
-#endif
 
     return 0;
-}
\ No newline at end of file
+}
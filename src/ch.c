@@ -0,0 +1,890 @@
+/**
+ * @file    ch.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../inc/ch.h"
+
+#define UP      0
+#define DOWN    1
+
+// first bytes of a file written by ch_save
+#define CH_MAGIC    "CHv2"
+
+// initial capacity of an arc list
+#define CH_ARCS_MIN 4
+
+/**
+ * @brief Edge of the graph being contracted
+ *
+ */
+typedef struct ch_arc_s
+{
+    int v;                  // other end
+    int w;                  // weight
+    int mid;                // vertex bypassed by a shortcut, -1 for original edges
+
+}ch_arc_t;
+
+typedef struct ch_arcs_s
+{
+    ch_arc_t*   a;
+    int         n;
+    int         cap;
+
+}ch_arcs_t;
+
+/**
+ * @brief State of the contraction. The arc lists only hold vertices not yet
+ *        contracted, so once v is contracted its own lists are its upward and
+ *        downward edges
+ *
+ */
+typedef struct ch_build_s
+{
+    int         nv;
+    ch_arcs_t*  out;
+    ch_arcs_t*  in;
+    bool*       contracted;
+    int*        deleted;        // contracted neighbours of each vertex
+    int*        level;          // longest chain of contracted vertices below each vertex
+    int*        prio;
+
+    // witness searches
+    unsigned    stamp;
+    unsigned*   seen;
+    unsigned*   target;         // stamped for the out-neighbours of the vertex being contracted
+    int*        dist;
+    heap_t*     q;
+
+}ch_build_t;
+
+static
+void ch_push_arc(ch_arcs_t* l, int v, int w, int mid)
+{
+    if(l->n == l->cap)
+    {
+        l->cap = l->cap ? 2 * l->cap : CH_ARCS_MIN;
+        l->a = realloc(l->a, l->cap * sizeof(ch_arc_t));
+    }
+
+    l->a[l->n].v = v;
+    l->a[l->n].w = w;
+    l->a[l->n].mid = mid;
+    l->n++;
+}
+
+static
+ch_arc_t* ch_find_arc(ch_arcs_t* l, int v)
+{
+    for(int i = 0; i < l->n; i++)
+    {
+        if(l->a[i].v == v)
+            return &l->a[i];
+    }
+
+    return NULL;
+}
+
+static
+void ch_remove_arc(ch_arcs_t* l, int v)
+{
+    ch_arc_t* a = ch_find_arc(l, v);
+
+    if(a)
+        *a = l->a[--l->n];
+}
+
+/**
+ * @brief Add the edge u -> v, or lower its weight if it is already there
+ */
+static
+void ch_add_arc(ch_build_t* b, int u, int v, int w, int mid)
+{
+    ch_arc_t* a = ch_find_arc(&b->out[u], v);
+
+    if(a == NULL)
+    {
+        ch_push_arc(&b->out[u], v, w, mid);
+        ch_push_arc(&b->in[v], u, w, mid);
+    }
+    else if(w < a->w)
+    {
+        a->w = w;
+        a->mid = mid;
+
+        a = ch_find_arc(&b->in[v], u);
+        a->w = w;
+        a->mid = mid;
+    }
+}
+
+/**
+ * @brief Dijkstra from u that never enters v, until every out-neighbour of v is settled,
+ *        or up to cost maxc or limit settled vertices. Afterwards b->dist holds
+ *        upper bounds on the costs from u for the vertices stamped with b->stamp
+ */
+static
+void ch_witness(ch_build_t* b, int u, int v, int maxc, int limit)
+{
+    key_value_t item;
+    int settled = 0;
+    int left = 0;
+
+    //stamps are about to repeat, clear them once every 2^32 searches
+    if(++b->stamp == 0)
+    {
+        memset(b->seen, 0, b->nv * sizeof(unsigned));
+        memset(b->target, 0, b->nv * sizeof(unsigned));
+        b->stamp = 1;
+    }
+
+    for(int i = 0; i < b->out[v].n; i++)
+    {
+        int w = b->out[v].a[i].v;
+
+        if(w != u && b->target[w] != b->stamp)
+        {
+            b->target[w] = b->stamp;
+            left++;
+        }
+    }
+
+    b->q->ctr = 0;
+    b->seen[u] = b->stamp;
+    b->dist[u] = 0;
+    min_insert(b->q, u, 0);
+
+    while(extract_min(b->q, &item) && item.value <= maxc && settled < limit)
+    {
+        int x = item.key;
+        ch_arcs_t* l = &b->out[x];
+
+        if(item.value > b->dist[x])
+            continue;
+
+        if(b->target[x] == b->stamp && --left == 0)
+            break;
+
+        settled++;
+        for(int i = 0; i < l->n; i++)
+        {
+            int y = l->a[i].v;
+            int c = b->dist[x] + l->a[i].w;
+
+            if(y == v)
+                continue;
+
+            if(b->seen[y] != b->stamp || c < b->dist[y])
+            {
+                b->seen[y] = b->stamp;
+                b->dist[y] = c;
+                min_insert(b->q, y, c);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Count the shortcuts that contracting v needs, and add them unless simulating
+ */
+static
+int ch_contract(ch_build_t* b, int v, bool simulate)
+{
+    ch_arcs_t* in = &b->in[v];
+    ch_arcs_t* out = &b->out[v];
+    int shortcuts = 0;
+
+    for(int i = 0; i < in->n; i++)
+    {
+        int u = in->a[i].v;
+        int maxc = -1;
+
+        for(int j = 0; j < out->n; j++)
+        {
+            if(out->a[j].v != u && in->a[i].w + out->a[j].w > maxc)
+                maxc = in->a[i].w + out->a[j].w;
+        }
+
+        if(maxc < 0)
+            continue;
+
+        ch_witness(b, u, v, maxc, simulate ? CH_SIMULATE_LIMIT : CH_WITNESS_LIMIT);
+
+        for(int j = 0; j < out->n; j++)
+        {
+            int w = out->a[j].v;
+            int c = in->a[i].w + out->a[j].w;
+
+            //a path u -> w avoiding v is as short, no shortcut needed
+            if(w == u || (b->seen[w] == b->stamp && b->dist[w] <= c))
+                continue;
+
+            shortcuts++;
+            if(!simulate)
+                ch_add_arc(b, u, w, c, v);
+        }
+    }
+
+    return shortcuts;
+}
+
+/**
+ * @brief Contraction order: edge difference, spread over the graph by the deleted 
+ *        neighbours, and kept shallow by the level, which shortens the upward searches
+ */
+static
+int ch_priority(ch_build_t* b, int v)
+{
+    int ed = ch_contract(b, v, true) - b->in[v].n - b->out[v].n;
+
+    return 2 * ed + b->deleted[v] + 2 * b->level[v];
+}
+
+/**
+ * @brief Copy the frozen arc lists into a CSR graph numbered by rank, with the
+ *        bypassed vertices in mid
+ */
+static
+csr_graph_t* ch_freeze(ch_arcs_t* lists, const ch_t* ch, int** mid)
+{
+    csr_graph_t* g = malloc(sizeof(csr_graph_t));
+    int nv = ch->nv;
+    int ne = 0;
+
+    for(int v = 0; v < nv; v++)
+        ne += lists[v].n;
+
+    g->nv = nv;
+    g->ne = ne;
+    g->dir = DIRECTED;
+    g->offset = malloc((nv + 1) * sizeof(int));
+    g->target = malloc(ne * sizeof(int));
+    g->weight = malloc(ne * sizeof(int));
+    *mid = malloc(ne * sizeof(int));
+
+    ne = 0;
+    for(int r = 0; r < nv; r++)
+    {
+        ch_arcs_t* l = &lists[ch->vertex[r]];
+
+        g->offset[r] = ne;
+        for(int i = 0; i < l->n; i++, ne++)
+        {
+            g->target[ne] = ch->rank[l->a[i].v];
+            g->weight[ne] = l->a[i].w;
+            (*mid)[ne] = l->a[i].mid == -1 ? -1 : ch->rank[l->a[i].mid];
+        }
+    }
+    g->offset[nv] = ne;
+
+    return g;
+}
+
+ch_t* ch_build(graph_t* g)
+{
+    ch_t* ch = malloc(sizeof(ch_t));
+    heap_t* order_q = min_heap(g->nv);
+    ch_build_t b;
+    key_value_t item;
+    int order = 0;
+
+    b.nv = g->nv;
+    b.out = calloc(g->nv, sizeof(ch_arcs_t));
+    b.in = calloc(g->nv, sizeof(ch_arcs_t));
+    b.contracted = calloc(g->nv, sizeof(bool));
+    b.deleted = calloc(g->nv, sizeof(int));
+    b.level = calloc(g->nv, sizeof(int));
+    b.prio = malloc(g->nv * sizeof(int));
+    b.stamp = 0;
+    b.seen = calloc(g->nv, sizeof(unsigned));
+    b.target = calloc(g->nv, sizeof(unsigned));
+    b.dist = malloc(g->nv * sizeof(int));
+    b.q = min_heap(64);
+
+    ch->nv = g->nv;
+    ch->rank = malloc(g->nv * sizeof(int));
+    ch->vertex = malloc(g->nv * sizeof(int));
+
+    //self loops never lie on a shortest path, and parallel edges keep the lightest
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(struct node* tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            if(tmp->v != u)
+                ch_add_arc(&b, u, tmp->v, tmp->w, -1);
+        }
+    }
+
+    for(int v = 0; v < g->nv; v++)
+    {
+        b.prio[v] = ch_priority(&b, v);
+        min_insert(order_q, v, b.prio[v]);
+    }
+
+    while(extract_min(order_q, &item))
+    {
+        int v = item.key;
+
+        if(b.contracted[v] || item.value != b.prio[v])
+            continue;
+
+        //lazy update: if v got worse since it was queued, try again later
+        b.prio[v] = ch_priority(&b, v);
+        if(order_q->ctr && b.prio[v] > order_q->pair[0].value)
+        {
+            min_insert(order_q, v, b.prio[v]);
+            continue;
+        }
+
+        ch_contract(&b, v, false);
+        b.contracted[v] = true;
+        ch->vertex[order] = v;
+        ch->rank[v] = order++;
+
+        //take v out of its neighbours' lists, freezing its own
+        for(int i = 0; i < b.in[v].n; i++)
+            ch_remove_arc(&b.out[b.in[v].a[i].v], v);
+        for(int i = 0; i < b.out[v].n; i++)
+            ch_remove_arc(&b.in[b.out[v].a[i].v], v);
+
+        for(int s = 0; s < 2; s++)
+        {
+            ch_arcs_t* l = s ? &b.out[v] : &b.in[v];
+
+            for(int i = 0; i < l->n; i++)
+            {
+                int x = l->a[i].v;
+
+                //only the cheap term changes here, the shortcuts are counted again when x comes up
+                b.deleted[x]++;
+                b.prio[x]++;
+                if(b.level[x] <= b.level[v])
+                {
+                    b.prio[x] += 2 * (b.level[v] + 1 - b.level[x]);
+                    b.level[x] = b.level[v] + 1;
+                }
+                min_insert(order_q, x, b.prio[x]);
+            }
+        }
+    }
+
+    ch->up = ch_freeze(b.out, ch, &ch->up_mid);
+    ch->down = ch_freeze(b.in, ch, &ch->down_mid);
+
+    for(int v = 0; v < g->nv; v++)
+    {
+        free(b.out[v].a);
+        free(b.in[v].a);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.contracted);
+    free(b.deleted);
+    free(b.level);
+    free(b.prio);
+    free(b.seen);
+    free(b.target);
+    free(b.dist);
+    destroy_heap(b.q);
+    destroy_heap(order_q);
+
+    return ch;
+}
+
+void ch_destroy(ch_t* ch)
+{
+    if(ch == NULL)
+        return;
+
+    csr_destroy(ch->up);
+    csr_destroy(ch->down);
+    free(ch->up_mid);
+    free(ch->down_mid);
+    free(ch->rank);
+    free(ch->vertex);
+    free(ch);
+}
+
+ch_query_t* ch_query_create(const ch_t* ch)
+{
+    ch_query_t* q = malloc(sizeof(ch_query_t));
+
+    q->ch = ch;
+    q->touched = 0;
+
+    for(int s = UP; s <= DOWN; s++)
+    {
+        q->cost[s] = (int*)malloc(ch->nv * sizeof(int));
+        q->prev[s] = (int*)malloc(ch->nv * sizeof(int));
+        q->edge[s] = (int*)malloc(ch->nv * sizeof(int));
+        q->reached[s] = (int*)malloc(ch->nv * sizeof(int));
+        q->nreached[s] = 0;
+        q->q[s] = dheap_create(ch->nv, CH_HEAP_ARITY);
+
+        for(int v = 0; v < ch->nv; v++)
+            q->cost[s][v] = INT_MAX;
+    }
+
+    return q;
+}
+
+void ch_query_destroy(ch_query_t* q)
+{
+    if(q == NULL)
+        return;
+
+    for(int s = UP; s <= DOWN; s++)
+    {
+        free(q->cost[s]);
+        free(q->prev[s]);
+        free(q->edge[s]);
+        free(q->reached[s]);
+        dheap_destroy(q->q[s]);
+    }
+
+    free(q);
+}
+
+/**
+ * @brief Index of the edge from v to target in a search graph, -1 if none
+ */
+static
+int ch_edge(const csr_graph_t* g, int v, int target)
+{
+    for(int e = g->offset[v]; e < g->offset[v + 1]; e++)
+    {
+        if(g->target[e] == target)
+            return e;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Append vertex r, numbered by rank, to path under its own number
+ */
+static
+void ch_append(const ch_t* ch, path_t* path, int* cap, int r)
+{
+    if(path->n == *cap)
+    {
+        *cap *= 2;
+        path->v = realloc(path->v, *cap * sizeof(int));
+    }
+
+    path->v[path->n++] = ch->vertex[r];
+}
+
+/**
+ * @brief Append to path the vertices after u on the original edges that the
+ *        edge u -> v with bypassed vertex mid stands for
+ */
+static
+void ch_unpack(const ch_t* ch, int u, int v, int mid, path_t* path, int* cap)
+{
+    //edges still to unpack as (from, to, mid), the next one in path order on top
+    int size = 16, n = 1;
+    int* stack = malloc(3 * size * sizeof(int));
+
+    stack[0] = u;
+    stack[1] = v;
+    stack[2] = mid;
+
+    while(n)
+    {
+        int* top = &stack[3 * --n];
+        int a = top[0], b = top[1], m = top[2];
+
+        if(m == -1)
+        {
+            ch_append(ch, path, cap, b);
+            continue;
+        }
+
+        if(n + 2 > size)
+        {
+            size *= 2;
+            stack = realloc(stack, 3 * size * sizeof(int));
+        }
+
+        //m ranks below both ends: a -> m is a downward edge, m -> b an upward one
+        stack[3 * n] = m;
+        stack[3 * n + 1] = b;
+        stack[3 * n + 2] = ch->up_mid[ch_edge(ch->up, m, b)];
+        n++;
+
+        stack[3 * n] = a;
+        stack[3 * n + 1] = m;
+        stack[3 * n + 2] = ch->down_mid[ch_edge(ch->down, m, a)];
+        n++;
+    }
+
+    free(stack);
+}
+
+/**
+ * @brief Expand the path src .. meet .. dst of the two searches into original edges
+ */
+static
+void ch_path(ch_query_t* q, int meet, path_t* path)
+{
+    const ch_t* ch = q->ch;
+    int cap = 16, len = 0;
+    int* chain;
+
+    //the upward parents lead back from meet to src, so that half is reversed first
+    for(int x = meet; q->prev[UP][x] != -1; x = q->prev[UP][x])
+        len++;
+
+    chain = malloc((len + 1) * sizeof(int));
+    for(int i = len, x = meet; i >= 0; i--, x = q->prev[UP][x])
+        chain[i] = x;
+
+    path->v = (int*)malloc(cap * sizeof(int));
+    path->n = 0;
+    ch_append(ch, path, &cap, chain[0]);
+
+    for(int i = 0; i < len; i++)
+        ch_unpack(ch, chain[i], chain[i + 1], ch->up_mid[q->edge[UP][chain[i + 1]]], path, &cap);
+
+    //the downward parents already lead from meet to dst
+    for(int x = meet; q->prev[DOWN][x] != -1; x = q->prev[DOWN][x])
+        ch_unpack(ch, x, q->prev[DOWN][x], ch->down_mid[q->edge[DOWN][x]], path, &cap);
+
+    free(chain);
+}
+
+/**
+ * @brief Stall-on-demand: u need not be expanded when a higher vertex already reached 
+ *        by search s gets to it more cheaply, as its cost is then not a shortest one
+ */
+static inline
+bool ch_stalled(ch_query_t* q, int s, int u)
+{
+    //edges into u from above, in the direction of search s
+    const csr_graph_t* g = s == UP ? q->ch->down : q->ch->up;
+    const int* cost = q->cost[s];
+    int cu = cost[u];
+
+    for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+    {
+        //cost[x] + w < cu, never true for an unreached x at INT_MAX
+        if(cost[g->target[e]] < cu - g->weight[e])
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Lower the cost of v in search s to c through edge e from u
+ */
+static inline
+void ch_reach(ch_query_t* q, int s, int u, int v, int e, int c)
+{
+    if(q->cost[s][v] == INT_MAX)
+    {
+        q->reached[s][q->nreached[s]++] = v;
+        dheap_insert(q->q[s], v, c);
+    }
+    else
+        dheap_decrease_key(q->q[s], v, c);
+
+    q->cost[s][v] = c;
+    q->prev[s][v] = u;
+    q->edge[s][v] = e;
+}
+
+int ch_query(ch_query_t* q, int src, int dst, path_t* path)
+{
+    const ch_t* ch = q->ch;
+    long long best = LLONG_MAX;
+    int meet = -1;
+    key_value_t item, top[2];
+
+    //forget the previous query
+    for(int s = UP; s <= DOWN; s++)
+    {
+        for(int i = 0; i < q->nreached[s]; i++)
+            q->cost[s][q->reached[s][i]] = INT_MAX;
+
+        q->nreached[s] = 0;
+        dheap_clear(q->q[s]);
+    }
+
+    ch_reach(q, UP, -1, ch->rank[src], -1, 0);
+    ch_reach(q, DOWN, -1, ch->rank[dst], -1, 0);
+
+    for(;;)
+    {
+        bool up = dheap_min(q->q[UP], &top[UP]) && top[UP].value < best;
+        bool down = dheap_min(q->q[DOWN], &top[DOWN]) && top[DOWN].value < best;
+        int s, u, cu;
+        const csr_graph_t* g;
+
+        //every path not yet seen costs at least best
+        if(!up && !down)
+            break;
+
+        s = (up && (!down || top[UP].value <= top[DOWN].value)) ? UP : DOWN;
+        g = s == UP ? ch->up : ch->down;
+
+        dheap_extract_min(q->q[s], &item);
+        u = item.key;
+        cu = q->cost[s][u];
+
+        if(q->cost[!s][u] != INT_MAX && (long long)cu + q->cost[!s][u] < best)
+        {
+            best = (long long)cu + q->cost[!s][u];
+            meet = u;
+        }
+
+        if(ch_stalled(q, s, u))
+            continue;
+
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int v = g->target[e];
+            int c = cu + g->weight[e];
+
+            if(c < q->cost[s][v])
+                ch_reach(q, s, u, v, e, c);
+        }
+    }
+
+    q->touched = q->nreached[UP] + q->nreached[DOWN];
+
+    if(meet == -1)
+    {
+        if(path)
+        {
+            path->v = NULL;
+            path->n = 0;
+        }
+
+        return INT_MAX;
+    }
+
+    if(path)
+        ch_path(q, meet, path);
+
+    return (int)best;
+}
+
+/**
+ * @brief Write a search graph and its bypassed vertices
+ */
+static
+bool ch_write_graph(FILE* f, const csr_graph_t* g, const int* mid)
+{
+    return fwrite(&g->ne, sizeof(int), 1, f) == 1 &&
+           fwrite(g->offset, sizeof(int), g->nv + 1, f) == (size_t)g->nv + 1 &&
+           fwrite(g->target, sizeof(int), g->ne, f) == (size_t)g->ne &&
+           fwrite(g->weight, sizeof(int), g->ne, f) == (size_t)g->ne &&
+           fwrite(mid, sizeof(int), g->ne, f) == (size_t)g->ne;
+}
+
+bool ch_save(const ch_t* ch, const char* file)
+{
+    FILE* f = fopen(file, "wb");
+    bool ok;
+
+    if(f == NULL)
+        return false;
+
+    ok = fwrite(CH_MAGIC, 1, 4, f) == 4 &&
+         fwrite(&ch->nv, sizeof(int), 1, f) == 1 &&
+         fwrite(ch->rank, sizeof(int), ch->nv, f) == (size_t)ch->nv &&
+         ch_write_graph(f, ch->up, ch->up_mid) &&
+         ch_write_graph(f, ch->down, ch->down_mid);
+
+    return fclose(f) == 0 && ok;
+}
+
+/**
+ * @brief Check a search graph read from a file: offsets in order from 0 to ne, 
+ *        non-negative weights, and every edge going up from its lower end to a 
+ *        higher target, with the vertex it bypasses, if any, below that end
+ */
+static
+bool ch_valid_graph(const csr_graph_t* g, const int* mid)
+{
+    if(g->offset[0] != 0 || g->offset[g->nv] != g->ne)
+        return false;
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        if(g->offset[u] > g->offset[u + 1])
+            return false;
+    }
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            if(g->target[e] <= u || g->target[e] >= g->nv || g->weight[e] < 0 ||
+               mid[e] < -1 || mid[e] >= u)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check that the two edges each shortcut stands for are in the hierarchy, 
+ *        so ch_unpack() always finds them. An upward edge u -> v over m is made of 
+ *        the downward edge u -> m and the upward edge m -> v; a downward edge v -> u, 
+ *        stored at u, of the downward edge v -> m and the upward edge m -> u
+ */
+static
+bool ch_valid_shortcuts(const ch_t* ch)
+{
+    for(int s = UP; s <= DOWN; s++)
+    {
+        const csr_graph_t* g = s == UP ? ch->up : ch->down;
+        const int* mid = s == UP ? ch->up_mid : ch->down_mid;
+
+        for(int u = 0; u < g->nv; u++)
+        {
+            for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+            {
+                int m = mid[e], v = g->target[e];
+
+                if(m == -1)
+                    continue;
+
+                if(s == UP && (ch_edge(ch->down, m, u) == -1 || ch_edge(ch->up, m, v) == -1))
+                    return false;
+                if(s == DOWN && (ch_edge(ch->down, m, v) == -1 || ch_edge(ch->up, m, u) == -1))
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Room for n ints read from a file. Not NULL only because n is 0, as 
+ *        malloc(0) may be, so that empty hierarchies and edgeless graphs load too
+ */
+static
+int* ch_alloc_ints(int n)
+{
+    return malloc((n > 0 ? n : 1) * sizeof(int));
+}
+
+/**
+ * @brief Read a search graph written by ch_write_graph, NULL if it is not a valid one
+ */
+static
+csr_graph_t* ch_read_graph(FILE* f, int nv, int** mid)
+{
+    csr_graph_t* g;
+    int ne;
+
+    if(fread(&ne, sizeof(int), 1, f) != 1 || ne < 0)
+        return NULL;
+
+    g = malloc(sizeof(csr_graph_t));
+    g->nv = nv;
+    g->ne = ne;
+    g->dir = DIRECTED;
+    g->offset = malloc((nv + 1) * sizeof(int));
+    g->target = ch_alloc_ints(ne);
+    g->weight = ch_alloc_ints(ne);
+    *mid = ch_alloc_ints(ne);
+
+    //a corrupt edge count may ask for more memory than there is
+    if(g->offset == NULL || g->target == NULL || g->weight == NULL || *mid == NULL ||
+       fread(g->offset, sizeof(int), nv + 1, f) != (size_t)nv + 1 ||
+       fread(g->target, sizeof(int), ne, f) != (size_t)ne ||
+       fread(g->weight, sizeof(int), ne, f) != (size_t)ne ||
+       fread(*mid, sizeof(int), ne, f) != (size_t)ne ||
+       !ch_valid_graph(g, *mid))
+    {
+        csr_destroy(g);
+        free(*mid);
+        return NULL;
+    }
+
+    return g;
+}
+
+ch_t* ch_load(const char* file)
+{
+    FILE* f = fopen(file, "rb");
+    char magic[4];
+    ch_t* ch;
+    int nv;
+    bool ok;
+
+    if(f == NULL)
+        return NULL;
+
+    if(fread(magic, 1, 4, f) != 4 || memcmp(magic, CH_MAGIC, 4) != 0 ||
+       fread(&nv, sizeof(int), 1, f) != 1 || nv < 0 || nv == INT_MAX)
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    ch = malloc(sizeof(ch_t));
+    ch->nv = nv;
+    ch->rank = ch_alloc_ints(nv);
+    ch->vertex = ch_alloc_ints(nv);
+    ch->up = NULL;
+    ch->down = NULL;
+
+    ok = ch->rank != NULL && ch->vertex != NULL &&
+         fread(ch->rank, sizeof(int), nv, f) == (size_t)nv;
+
+    //rank must be a permutation of [0,nv), checked as vertex is filled
+    for(int r = 0; ok && r < nv; r++)
+        ch->vertex[r] = -1;
+
+    for(int v = 0; ok && v < nv; v++)
+    {
+        int r = ch->rank[v];
+
+        ok = r >= 0 && r < nv && ch->vertex[r] == -1;
+        if(ok)
+            ch->vertex[r] = v;
+    }
+
+    ok = ok &&
+         (ch->up = ch_read_graph(f, nv, &ch->up_mid)) != NULL &&
+         (ch->down = ch_read_graph(f, nv, &ch->down_mid)) != NULL &&
+         ch_valid_shortcuts(ch);
+
+    fclose(f);
+
+    if(!ok)
+    {
+        if(ch->up)
+        {
+            csr_destroy(ch->up);
+            free(ch->up_mid);
+        }
+        if(ch->down)
+        {
+            csr_destroy(ch->down);
+            free(ch->down_mid);
+        }
+        free(ch->rank);
+        free(ch->vertex);
+        free(ch);
+        return NULL;
+    }
+
+    return ch;
+}
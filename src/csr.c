@@ -0,0 +1,613 @@
+/**
+ * @file    csr.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../inc/csr.h"
+#include "../inc/dheap.h"
+#include "../inc/threadpool.h"
+
+// fewest frontier vertices worth a block of their own in the parallel BFS
+#define BFS_PARALLEL_GRAIN  1024
+
+/**
+ * @brief Allocate a CSR graph with room for ne edges and zeroed offsets
+ */
+static
+csr_graph_t* csr_alloc(int nv, int ne, bool dir)
+{
+    csr_graph_t* g = malloc(sizeof(csr_graph_t));
+
+    g->nv = nv;
+    g->ne = ne;
+    g->dir = dir;
+    g->offset = calloc(nv + 1, sizeof(int));
+    g->target = malloc(ne * sizeof(int));
+    g->weight = malloc(ne * sizeof(int));
+
+    return g;
+}
+
+csr_graph_t* csr_from_graph(graph_t* g)
+{
+    csr_graph_t* csr;
+    struct node* tmp;
+    int ne = 0;
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+            ne++;
+    }
+
+    csr = csr_alloc(g->nv, ne, g->dir);
+
+    //the adjacency lists are already grouped by source, so they are copied in order
+    ne = 0;
+    for(int u = 0; u < g->nv; u++)
+    {
+        csr->offset[u] = ne;
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            csr->target[ne] = tmp->v;
+            csr->weight[ne] = tmp->w;
+            ne++;
+        }
+    }
+    csr->offset[g->nv] = ne;
+
+    return csr;
+}
+
+csr_graph_t* csr_from_edges(int nv, bool dir, const edge_t* edges, int ne)
+{
+    csr_graph_t* csr = csr_alloc(nv, dir ? ne : 2 * ne, dir);
+    int* next;
+
+    //count the out-degree of each vertex, one slot ahead
+    for(int e = 0; e < ne; e++)
+    {
+        csr->offset[edges[e].u + 1]++;
+        if(!dir)
+            csr->offset[edges[e].v + 1]++;
+    }
+
+    for(int u = 0; u < nv; u++)
+        csr->offset[u + 1] += csr->offset[u];
+
+    //scatter each edge to the next free slot of its source
+    next = malloc(nv * sizeof(int));
+    memcpy(next, csr->offset, nv * sizeof(int));
+
+    for(int e = 0; e < ne; e++)
+    {
+        int i = next[edges[e].u]++;
+
+        csr->target[i] = edges[e].v;
+        csr->weight[i] = edges[e].w;
+
+        if(!dir)
+        {
+            i = next[edges[e].v]++;
+            csr->target[i] = edges[e].u;
+            csr->weight[i] = edges[e].w;
+        }
+    }
+
+    free(next);
+
+    return csr;
+}
+
+csr_graph_t* csr_transpose(csr_graph_t* g)
+{
+    csr_graph_t* t = csr_alloc(g->nv, g->ne, g->dir);
+    int* next;
+
+    for(int e = 0; e < g->ne; e++)
+        t->offset[g->target[e] + 1]++;
+
+    for(int v = 0; v < g->nv; v++)
+        t->offset[v + 1] += t->offset[v];
+
+    next = malloc(g->nv * sizeof(int));
+    memcpy(next, t->offset, g->nv * sizeof(int));
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int i = next[g->target[e]]++;
+
+            t->target[i] = u;
+            t->weight[i] = g->weight[e];
+        }
+    }
+
+    free(next);
+
+    return t;
+}
+
+void csr_destroy(csr_graph_t* g)
+{
+    if(g == NULL)
+        return;
+
+    free(g->offset);
+    free(g->target);
+    free(g->weight);
+    free(g);
+}
+
+/**
+ * @brief Allocate a single source shortest path result with every vertex unreached
+ */
+static
+sssp_t* sssp_alloc(int nv, int src)
+{
+    sssp_t* sssp = malloc(sizeof(sssp_t));
+
+    sssp->cost = (int*)malloc(nv * sizeof(int));
+    sssp->prev = (int*)malloc(nv * sizeof(int));
+
+    for(int j=0; j < nv; j++)
+    {
+        sssp->cost[j] = INT_MAX;
+        sssp->prev[j] = -1;
+    }
+    sssp->cost[src] = 0;
+
+    return sssp;
+}
+
+sssp_t* csr_bfs(csr_graph_t* g, int src)
+{
+    sssp_t* sssp = sssp_alloc(g->nv, src);
+    int* frontier = malloc(g->nv * sizeof(int));
+    int head = 0;
+    int tail = 0;
+
+    //every vertex is queued at most once, so a flat array is enough
+    frontier[tail++] = src;
+    while(head < tail)
+    {
+        int u = frontier[head++];
+
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int v = g->target[e];
+
+            if(sssp->cost[v] == INT_MAX)
+            {
+                sssp->cost[v] = sssp->cost[u] + 1;
+                sssp->prev[v] = u;
+                frontier[tail++] = v;
+            }
+        }
+    }
+
+    free(frontier);
+
+    return sssp;
+}
+
+#define BIT_GET(b, i)   (((b)[(i) >> 6] >> ((i) & 63)) & 1)
+#define BIT_SET(b, i)   ((b)[(i) >> 6] |= 1ULL << ((i) & 63))
+
+/**
+ * @brief Top-down step: expand every vertex of the frontier list over its out-edges
+ *
+ * @return number of vertices in the next frontier, written to next
+ */
+static
+int bfs_top_down(csr_graph_t* g, sssp_t* sssp, uint64_t* visited, const int* cur, int nf, int* next, long* mf)
+{
+    int nn = 0;
+
+    for(int i = 0; i < nf; i++)
+    {
+        int u = cur[i];
+
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int v = g->target[e];
+
+            if(!BIT_GET(visited, v))
+            {
+                BIT_SET(visited, v);
+                sssp->cost[v] = sssp->cost[u] + 1;
+                sssp->prev[v] = u;
+                next[nn++] = v;
+                *mf += g->offset[v + 1] - g->offset[v];
+            }
+        }
+    }
+
+    return nn;
+}
+
+/**
+ * @brief Bottom-up step: every unvisited vertex looks for a parent in the 
+ *        frontier bitmap among its in-edges, stopping at the first one
+ *
+ * @return number of vertices in the next frontier, set in the next bitmap
+ */
+static
+int bfs_bottom_up(csr_graph_t* g, csr_graph_t* in, sssp_t* sssp, uint64_t* visited, 
+                  const uint64_t* front, uint64_t* next, int level, long* mf)
+{
+    int words = (g->nv + 63) / 64;
+    int nn = 0;
+
+    memset(next, 0, words * sizeof(uint64_t));
+
+    for(int w = 0; w < words; w++)
+    {
+        //only the vertices still unvisited in this word
+        uint64_t todo = ~visited[w];
+
+        if(w == words - 1 && (g->nv & 63))
+            todo &= (1ULL << (g->nv & 63)) - 1;
+
+        while(todo)
+        {
+            int v = w * 64 + __builtin_ctzll(todo);
+            todo &= todo - 1;
+
+            for(int e = in->offset[v]; e < in->offset[v + 1]; e++)
+            {
+                int u = in->target[e];
+
+                if(BIT_GET(front, u))
+                {
+                    BIT_SET(visited, v);
+                    BIT_SET(next, v);
+                    sssp->cost[v] = level;
+                    sssp->prev[v] = u;
+                    *mf += g->offset[v + 1] - g->offset[v];
+                    nn++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return nn;
+}
+
+sssp_t* csr_bfs_do(csr_graph_t* g, csr_graph_t* in, int src)
+{
+    sssp_t* sssp = sssp_alloc(g->nv, src);
+    int words = (g->nv + 63) / 64;
+    uint64_t* visited = calloc(words, sizeof(uint64_t));
+    uint64_t* front = calloc(words, sizeof(uint64_t));
+    uint64_t* nextb = calloc(words, sizeof(uint64_t));
+    int* cur = malloc(g->nv * sizeof(int));
+    int* next = malloc(g->nv * sizeof(int));
+    bool bottom_up = false;
+    int level = 0;
+    int nf = 1;                                     // vertices in the frontier
+    int prev_nf = 0;
+    long mf = g->offset[src + 1] - g->offset[src];  // edges out of the frontier
+    long mu = g->ne - mf;                           // edges out of unvisited vertices
+    csr_graph_t* own = NULL;                        // transpose built here, if any
+
+    //the out-edges of an undirected graph are also its in-edges
+    if(in == NULL && !g->dir)
+        in = g;
+
+    BIT_SET(visited, src);
+    cur[0] = src;
+
+    while(nf > 0)
+    {
+        long mn = 0;
+        int nn;
+
+        if(!bottom_up && mf > mu / BFS_ALPHA)
+        {
+            //a directed graph given without its transpose gets one on the first bottom-up step
+            if(in == NULL)
+                in = own = csr_transpose(g);
+
+            //list to bitmap
+            memset(front, 0, words * sizeof(uint64_t));
+            for(int i = 0; i < nf; i++)
+                BIT_SET(front, cur[i]);
+            bottom_up = true;
+        }
+        else if(bottom_up && nf < prev_nf && nf < g->nv / BFS_BETA)
+        {
+            //bitmap to list
+            nf = 0;
+            for(int w = 0; w < words; w++)
+            {
+                for(uint64_t b = front[w]; b; b &= b - 1)
+                    cur[nf++] = w * 64 + __builtin_ctzll(b);
+            }
+            bottom_up = false;
+        }
+
+        level++;
+        if(bottom_up)
+        {
+            uint64_t* tmp;
+
+            nn = bfs_bottom_up(g, in, sssp, visited, front, nextb, level, &mn);
+            tmp = front;
+            front = nextb;
+            nextb = tmp;
+        }
+        else
+        {
+            int* tmp;
+
+            nn = bfs_top_down(g, sssp, visited, cur, nf, next, &mn);
+            tmp = cur;
+            cur = next;
+            next = tmp;
+        }
+
+        prev_nf = nf;
+        nf = nn;
+        mf = mn;
+        mu -= mn;
+    }
+
+    free(visited);
+    free(front);
+    free(nextb);
+    free(cur);
+    free(next);
+    csr_destroy(own);
+
+    return sssp;
+}
+
+/**
+ * @brief State of a parallel BFS level shared by its blocks
+ *
+ */
+typedef struct pbfs_s
+{
+    csr_graph_t*    g;
+    sssp_t*         sssp;
+    int             level;
+    const int*      cur;            // frontier
+    int             nf;
+    int             nblocks;
+    int**           buf;            // next-frontier vertices claimed by each block
+    int*            cap;
+    int*            cnt;
+    int*            pos;            // offset of each block in next, prefix sum of cnt
+    int*            next;
+
+}pbfs_t;
+
+/**
+ * @brief Expand the frontier vertices of blocks [lo,hi)
+ */
+static
+void pbfs_expand(int lo, int hi, void* ctx)
+{
+    pbfs_t* p = ctx;
+    int* prev = p->sssp->prev;
+
+    for(int b = lo; b < hi; b++)
+    {
+        int first = (int)((long long)p->nf * b / p->nblocks);
+        int last = (int)((long long)p->nf * (b + 1) / p->nblocks);
+        int n = 0;
+
+        for(int i = first; i < last; i++)
+        {
+            int u = p->cur[i];
+
+            for(int e = p->g->offset[u]; e < p->g->offset[u + 1]; e++)
+            {
+                int v = p->g->target[e];
+                int none = -1;
+
+                //a plain load first keeps claimed vertices from bouncing their cache line
+                if(__atomic_load_n(&prev[v], __ATOMIC_RELAXED) != -1 ||
+                   !__atomic_compare_exchange_n(&prev[v], &none, u, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    continue;
+
+                p->sssp->cost[v] = p->level;
+
+                if(n == p->cap[b])
+                {
+                    p->cap[b] = 2 * p->cap[b];
+                    p->buf[b] = realloc(p->buf[b], p->cap[b] * sizeof(int));
+                }
+                p->buf[b][n++] = v;
+            }
+        }
+
+        p->cnt[b] = n;
+    }
+}
+
+/**
+ * @brief Copy the buffers of blocks [lo,hi) to their place in the next frontier
+ */
+static
+void pbfs_gather(int lo, int hi, void* ctx)
+{
+    pbfs_t* p = ctx;
+
+    for(int b = lo; b < hi; b++)
+        memcpy(p->next + p->pos[b], p->buf[b], p->cnt[b] * sizeof(int));
+}
+
+sssp_t* csr_parallel_bfs(csr_graph_t* g, int src, int nthreads)
+{
+    pool_t* pool = pool_create(nthreads);
+
+    //no threads to spread the levels on, search on this one
+    if(pool == NULL)
+        return csr_bfs(g, src);
+
+    sssp_t* sssp = sssp_alloc(g->nv, src);
+    int maxblocks = 4 * pool->nthreads;
+    int* cur = malloc(g->nv * sizeof(int));
+    pbfs_t p;
+
+    p.g = g;
+    p.sssp = sssp;
+    p.next = malloc(g->nv * sizeof(int));
+    p.buf = malloc(maxblocks * sizeof(int*));
+    p.cap = malloc(maxblocks * sizeof(int));
+    p.cnt = malloc(maxblocks * sizeof(int));
+    p.pos = malloc(maxblocks * sizeof(int));
+    for(int b = 0; b < maxblocks; b++)
+    {
+        p.cap[b] = BFS_PARALLEL_GRAIN;
+        p.buf[b] = malloc(p.cap[b] * sizeof(int));
+    }
+
+    //the source is its own parent while searching, so nobody claims it
+    sssp->prev[src] = src;
+    cur[0] = src;
+    p.nf = 1;
+    p.level = 0;
+
+    while(p.nf > 0)
+    {
+        int nn = 0;
+
+        p.level++;
+        p.cur = cur;
+        p.nblocks = (p.nf + BFS_PARALLEL_GRAIN - 1) / BFS_PARALLEL_GRAIN;
+        if(p.nblocks > maxblocks)
+            p.nblocks = maxblocks;
+
+        pool_parallel_for(pool, p.nblocks, 1, pbfs_expand, &p);
+
+        for(int b = 0; b < p.nblocks; b++)
+        {
+            p.pos[b] = nn;
+            nn += p.cnt[b];
+        }
+
+        pool_parallel_for(pool, p.nblocks, 1, pbfs_gather, &p);
+
+        int* tmp = cur;
+        cur = p.next;
+        p.next = tmp;
+        p.nf = nn;
+    }
+
+    sssp->prev[src] = -1;
+
+    for(int b = 0; b < maxblocks; b++)
+        free(p.buf[b]);
+    free(p.buf);
+    free(p.cap);
+    free(p.cnt);
+    free(p.pos);
+    free(p.next);
+    free(cur);
+    pool_destroy(pool);
+
+    return sssp;
+}
+
+sssp_t* csr_dijkstra(csr_graph_t* g, int src)
+{
+    sssp_t* sssp = sssp_alloc(g->nv, src);
+    dheap_t* heap = dheap_create(g->nv, DARY_HEAP_ARITY);
+    key_value_t item;
+
+    dheap_insert(heap, src, 0);
+    while(dheap_extract_min(heap, &item))
+    {
+        int u = item.key;
+
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int v = g->target[e];
+            int c = sssp->cost[u] + g->weight[e];
+
+            //relax, inserting v on its first relaxation
+            if(c < sssp->cost[v])
+            {
+                bool first = sssp->cost[v] == INT_MAX;
+
+                sssp->cost[v] = c;
+                sssp->prev[v] = u;
+
+                if(first)
+                    dheap_insert(heap, v, c);
+                else
+                    dheap_decrease_key(heap, v, c);
+            }
+        }
+    }
+
+    dheap_destroy(heap);
+
+    return sssp;
+}
+
+/**
+ * @brief One Bellman-Ford pass over every edge leaving a reached vertex
+ *
+ * @return true if a cost changed
+ */
+static
+bool csr_relax_all(csr_graph_t* g, sssp_t* sssp)
+{
+    bool changed = false;
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        int cu = sssp->cost[u];
+
+        if(cu == INT_MAX)
+            continue;
+
+        for(int e = g->offset[u]; e < g->offset[u + 1]; e++)
+        {
+            int v = g->target[e];
+
+            if(cu + g->weight[e] < sssp->cost[v])
+            {
+                sssp->cost[v] = cu + g->weight[e];
+                sssp->prev[v] = u;
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+sssp_t* csr_bellman_ford(csr_graph_t* g, int src)
+{
+    sssp_t* sssp = sssp_alloc(g->nv, src);
+    bool changed = true;
+
+    for(int i = 1; i < g->nv && changed; i++)
+        changed = csr_relax_all(g, sssp);
+
+    //costs still dropping after V-1 passes means a negative cycle
+    if(changed && csr_relax_all(g, sssp))
+    {
+        free(sssp->cost);
+        free(sssp->prev);
+        free(sssp);
+
+        return NULL;
+    }
+
+    return sssp;
+}
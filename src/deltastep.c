@@ -0,0 +1,362 @@
+/**
+ * @file    deltastep.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../inc/graphs.h"
+#include "../inc/threadpool.h"
+
+// fewest vertices worth a block of their own in a relaxation phase
+#define DELTA_GRAIN     1024
+
+// initial capacity of a vertex list
+#define DELTA_LIST_MIN  16
+
+/*
+ * Cost and previous vertex are packed in one 64-bit word, cost in the high half,
+ * so one CAS updates both and a smaller word always means a smaller cost
+ */
+#define PACK(cost, prev)    (((uint64_t)(uint32_t)(cost) << 32) | (uint32_t)(prev))
+#define COST(x)             ((int)((x) >> 32))
+#define PREV(x)             ((int)(uint32_t)(x))
+
+/**
+ * @brief Growable list of vertices
+ *
+ */
+typedef struct ds_list_s
+{
+    int*    v;
+    int     n;
+    int     cap;
+
+}ds_list_t;
+
+/**
+ * @brief Lists owned by one block of a phase, so threads never share them
+ *
+ */
+typedef struct ds_block_s
+{
+    ds_list_t*  bins;           // vertices reached in each bucket, a ring of nb bins
+    ds_list_t   settled;        // vertices whose heavy edges are due at the end of the bucket
+
+}ds_block_t;
+
+/**
+ * @brief State of a delta-stepping run
+ *
+ */
+typedef struct ds_s
+{
+    graph_t*        g;
+    uint64_t*       dist;           // packed cost and prev of each vertex
+    int*            stamp;          // last bucket each vertex was settled in
+    int             delta;          // bucket width
+    int             bucket;         // bucket being processed
+    int             mask;           // number of bins in a ring minus one
+    bool            heavy;          // relaxing heavy edges instead of light ones
+
+    ds_block_t*     blk;
+    int             maxblocks;
+    int             nblocks;        // blocks of the current phase
+
+    int*            in;             // vertices of the current phase
+    int             n;
+    int             cap;
+    int*            pos;            // offset of each block in a gather
+    int             gather_bin;     // bin gathered, -1 for the settled lists
+
+}ds_t;
+
+static inline
+void ds_push(ds_list_t* l, int v)
+{
+    if(l->n == l->cap)
+    {
+        l->cap = l->cap ? 2 * l->cap : DELTA_LIST_MIN;
+        l->v = realloc(l->v, l->cap * sizeof(int));
+    }
+
+    l->v[l->n++] = v;
+}
+
+/**
+ * @brief List of bucket i in a block. Pending costs never span more than 
+ *        max weight / delta + 2 buckets, so bucket i shares its bin with i + nb
+ */
+static inline
+ds_list_t* ds_bin(ds_t* ds, ds_block_t* b, int i)
+{
+    if(b->bins == NULL)
+        b->bins = calloc(ds->mask + 1, sizeof(ds_list_t));
+
+    return &b->bins[i & ds->mask];
+}
+
+/**
+ * @brief Atomic min of the cost of v to c through u. On success v goes to
+ *        the bin of its new bucket in block b
+ */
+static inline
+void ds_relax(ds_t* ds, ds_block_t* b, int u, int v, int c)
+{
+    uint64_t old = __atomic_load_n(&ds->dist[v], __ATOMIC_RELAXED);
+
+    while(COST(old) > c)
+    {
+        if(__atomic_compare_exchange_n(&ds->dist[v], &old, PACK(c, u), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            ds_push(ds_bin(ds, b, c / ds->delta), v);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Relax the light (w <= delta) or heavy (w > delta) edges of the vertices of blocks [lo,hi)
+ */
+static
+void ds_phase(int lo, int hi, void* ctx)
+{
+    ds_t* ds = ctx;
+
+    for(int k = lo; k < hi; k++)
+    {
+        ds_block_t* b = &ds->blk[k];
+        int first = (int)((long long)ds->n * k / ds->nblocks);
+        int last = (int)((long long)ds->n * (k + 1) / ds->nblocks);
+
+        for(int i = first; i < last; i++)
+        {
+            int u = ds->in[i];
+            int cu = COST(__atomic_load_n(&ds->dist[u], __ATOMIC_RELAXED));
+
+            if(!ds->heavy)
+            {
+                //stale entry, u has since moved to an earlier bucket
+                if(cu / ds->delta != ds->bucket)
+                    continue;
+
+                if(__atomic_exchange_n(&ds->stamp[u], ds->bucket, __ATOMIC_RELAXED) != ds->bucket)
+                    ds_push(&b->settled, u);
+            }
+
+            for(struct node* tmp = ds->g->adj[u]; tmp; tmp = tmp->next)
+            {
+                if((tmp->w > ds->delta) == ds->heavy)
+                    ds_relax(ds, b, u, tmp->v, cu + tmp->w);
+            }
+        }
+    }
+}
+
+static inline
+ds_list_t* ds_gathered(ds_t* ds, int k)
+{
+    ds_block_t* b = &ds->blk[k];
+
+    if(ds->gather_bin < 0)
+        return &b->settled;
+
+    return b->bins ? &b->bins[ds->gather_bin & ds->mask] : NULL;
+}
+
+static
+void ds_copy(int lo, int hi, void* ctx)
+{
+    ds_t* ds = ctx;
+
+    for(int k = lo; k < hi; k++)
+    {
+        ds_list_t* l = ds_gathered(ds, k);
+
+        if(l && l->n)
+        {
+            memcpy(ds->in + ds->pos[k], l->v, l->n * sizeof(int));
+            l->n = 0;
+        }
+    }
+}
+
+/**
+ * @brief Concatenate one bin (or the settled lists, bin -1) of every block
+ *        into the phase input, at offsets given by a prefix sum, and empty them
+ *
+ * @return number of vertices gathered
+ */
+static
+int ds_gather(ds_t* ds, pool_t* pool, int bin)
+{
+    int n = 0;
+
+    ds->gather_bin = bin;
+    for(int k = 0; k < ds->maxblocks; k++)
+    {
+        ds_list_t* l = ds_gathered(ds, k);
+
+        ds->pos[k] = n;
+        n += l ? l->n : 0;
+    }
+
+    if(n > ds->cap)
+    {
+        ds->cap = n;
+        ds->in = realloc(ds->in, n * sizeof(int));
+    }
+
+    if(n < DELTA_GRAIN)
+        ds_copy(0, ds->maxblocks, ds);
+    else
+        pool_parallel_for(pool, ds->maxblocks, 1, ds_copy, ds);
+    ds->n = n;
+
+    return n;
+}
+
+static
+void ds_run_phase(ds_t* ds, pool_t* pool, bool heavy)
+{
+    ds->heavy = heavy;
+    ds->nblocks = (ds->n + DELTA_GRAIN - 1) / DELTA_GRAIN;
+    if(ds->nblocks > ds->maxblocks)
+        ds->nblocks = ds->maxblocks;
+
+    pool_parallel_for(pool, ds->nblocks, 1, ds_phase, ds);
+}
+
+/**
+ * @brief Largest edge weight and number of edges of a graph
+ */
+static
+int ds_max_weight(graph_t* g, long* ne)
+{
+    int maxw = 1;
+
+    *ne = 0;
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(struct node* tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            (*ne)++;
+            if(tmp->w > maxw)
+                maxw = tmp->w;
+        }
+    }
+
+    return maxw;
+}
+
+/**
+ * @brief Finds the shortest paths from node src in a graph with non-negative weights
+ * using parallel delta-stepping. Vertices are kept in buckets of width delta and the
+ * buckets are processed in order: light edges are relaxed in parallel, again and again,
+ * until the bucket stays empty, then the heavy edges of every vertex settled in it
+ * are relaxed once. Costs and parents are updated with an atomic min
+ *
+ * @param g pointer to graph
+ * @param src source node
+ * @param delta bucket width, or <= 0 to derive it from the weights and the average degree
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ * @return sssp_t*, NULL if the thread pool cannot be created
+ */
+sssp_t* delta_stepping(graph_t* g, int src, int delta, int nthreads)
+{
+    pool_t* pool = pool_create(nthreads);
+
+    if(pool == NULL)
+        return NULL;
+
+    sssp_t* sssp = malloc(sizeof(sssp_t));
+    long ne;
+    int maxw = ds_max_weight(g, &ne);
+    int nb = 1;
+    ds_t ds;
+
+    //by default, the largest weight over the average degree
+    if(delta <= 0)
+        delta = ne ? (int)((long)maxw * g->nv / ne) : 1;
+    if(delta < 1)
+        delta = 1;
+
+    while(nb < maxw / delta + 2)
+        nb *= 2;
+
+    memset(&ds, 0, sizeof(ds_t));
+    ds.g = g;
+    ds.delta = delta;
+    ds.mask = nb - 1;
+    ds.maxblocks = 4 * pool->nthreads;
+    ds.blk = calloc(ds.maxblocks, sizeof(ds_block_t));
+    ds.pos = malloc(ds.maxblocks * sizeof(int));
+    ds.dist = malloc(g->nv * sizeof(uint64_t));
+    ds.stamp = malloc(g->nv * sizeof(int));
+
+    for(int j=0; j < g->nv; j++)
+    {
+        ds.dist[j] = PACK(INT_MAX, -1);
+        ds.stamp[j] = -1;
+    }
+    ds.dist[src] = PACK(0, -1);
+    ds_push(ds_bin(&ds, &ds.blk[0], 0), src);
+
+    for(ds.bucket = 0; ds.bucket >= 0; )
+    {
+        int next = -1;
+
+        while(ds_gather(&ds, pool, ds.bucket) > 0)
+            ds_run_phase(&ds, pool, false);
+
+        if(ds_gather(&ds, pool, -1) > 0)
+            ds_run_phase(&ds, pool, true);
+
+        //first non-empty bucket of any block, within one turn of the ring
+        for(int k = 0; k < ds.maxblocks; k++)
+        {
+            ds_block_t* b = &ds.blk[k];
+            int last = (next < 0) ? ds.bucket + nb : next;
+
+            for(int i = ds.bucket + 1; b->bins && i < last; i++)
+            {
+                if(b->bins[i & ds.mask].n)
+                {
+                    next = i;
+                    break;
+                }
+            }
+        }
+
+        ds.bucket = next;
+    }
+
+    sssp->cost = (int*)malloc(g->nv * sizeof(int));
+    sssp->prev = (int*)malloc(g->nv * sizeof(int));
+    for(int j=0; j < g->nv; j++)
+    {
+        sssp->cost[j] = COST(ds.dist[j]);
+        sssp->prev[j] = PREV(ds.dist[j]);
+    }
+
+    for(int k = 0; k < ds.maxblocks; k++)
+    {
+        for(int i = 0; ds.blk[k].bins && i < nb; i++)
+            free(ds.blk[k].bins[i].v);
+        free(ds.blk[k].bins);
+        free(ds.blk[k].settled.v);
+    }
+    free(ds.blk);
+    free(ds.pos);
+    free(ds.in);
+    free(ds.dist);
+    free(ds.stamp);
+    pool_destroy(pool);
+
+    return sssp;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file    dheap.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../inc/dheap.h"
+#include "../inc/sortnet.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DHEAP_X86
+#include <immintrin.h>
+
+#define AVX2    __attribute__((target("avx2")))
+#define SSE41   __attribute__((target("sse4.1")))
+#endif
+
+#define CACHE_LINE  64
+
+/*
+ * Index of the smallest of d priorities. The blocks are padded with INT_MAX 
+ * beyond the last item, so every child block can be read in full
+ */
+#define SCALAR_MIN_CHILD(name, d)               \
+static int name(const int* p)                   \
+{                                               \
+    int m = 0;                                  \
+    for(int i = 1; i < d; i++)                  \
+    {                                           \
+        if(p[i] < p[m])                         \
+            m = i;                              \
+    }                                           \
+    return m;                                   \
+}
+
+SCALAR_MIN_CHILD(scalar_min2, 2)
+SCALAR_MIN_CHILD(scalar_min4, 4)
+SCALAR_MIN_CHILD(scalar_min8, 8)
+SCALAR_MIN_CHILD(scalar_min16, 16)
+
+#ifdef DHEAP_X86
+
+SSE41 static
+int sse41_min4(const int* p)
+{
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i m = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+
+    return __builtin_ctz(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m))));
+}
+
+SSE41 static
+int sse41_min8(const int* p)
+{
+    __m128i lo = _mm_loadu_si128((const __m128i*)p);
+    __m128i hi = _mm_loadu_si128((const __m128i*)(p + 4));
+    __m128i m = _mm_min_epi32(lo, hi);
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lo, m))) |
+               _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(hi, m))) << 4;
+
+    return __builtin_ctz(mask);
+}
+
+AVX2 static
+int avx2_min8(const int* p)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    __m256i m = _mm256_min_epi32(v, _mm256_permute2x128_si256(v, v, 1));
+    m = _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+
+    return __builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m))));
+}
+
+#endif //DHEAP_X86
+
+/**
+ * @brief Pick the fastest child comparison for an arity on the running CPU
+ */
+static
+int (*select_min_child(int d))(const int*)
+{
+    int level = simd_level();
+
+    switch(d)
+    {
+        case 2:
+            return scalar_min2;
+
+        case 4:
+#ifdef DHEAP_X86
+            if(level >= SIMD_SSE41)
+                return sse41_min4;
+#endif
+            return scalar_min4;
+
+        case 8:
+#ifdef DHEAP_X86
+            if(level >= SIMD_AVX2)
+                return avx2_min8;
+            if(level >= SIMD_SSE41)
+                return sse41_min8;
+#endif
+            return scalar_min8;
+
+        case 16:
+            return scalar_min16;
+    }
+
+    (void)level;
+    return NULL;
+}
+
+dheap_t* dheap_create(int size, int d)
+{
+    dheap_t* heap;
+    size_t slots, bytes;
+
+    if(d != 2 && d != 4 && d != 8 && d != 16)
+        return NULL;
+
+    heap = malloc(sizeof(dheap_t));
+    heap->size = size;
+    heap->ctr = 0;
+    heap->d = d;
+    heap->min_child = select_min_child(d);
+
+    //shift of d-1 puts the children of every node on a d-aligned block, 
+    //and the extra slots let the last child block be read in full
+    slots = (size_t)size + 3 * d;
+    bytes = (slots * sizeof(int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    heap->prio = aligned_alloc(CACHE_LINE, bytes);
+    for(size_t i = 0; i < bytes / sizeof(int); i++)
+        heap->prio[i] = INT_MAX;
+
+    heap->key = malloc(size * sizeof(int));
+    heap->pos = malloc(size * sizeof(int));
+    for(int i = 0; i < size; i++)
+        heap->pos[i] = -1;
+
+    return heap;
+}
+
+void dheap_destroy(dheap_t* heap)
+{
+    if(heap == NULL)
+        return;
+
+    free(heap->prio);
+    free(heap->key);
+    free(heap->pos);
+    free(heap);
+}
+
+/**
+ * @brief Priority of slot j
+ */
+#define PRIO(h, j)  ((h)->prio[(j) + (h)->d - 1])
+
+/**
+ * @brief Place key k with priority v on slot j
+ */
+static inline
+void dheap_set(dheap_t* heap, int j, int k, int v)
+{
+    PRIO(heap, j) = v;
+    heap->key[j] = k;
+    heap->pos[k] = j;
+}
+
+/**
+ * @brief Move key k with priority v up from slot j to its place
+ */
+static
+void dheap_sift_up(dheap_t* heap, int j, int k, int v)
+{
+    int d = heap->d;
+
+    while(j > 0)
+    {
+        int parent = (j - 1) / d;
+
+        if(PRIO(heap, parent) <= v)
+            break;
+
+        dheap_set(heap, j, heap->key[parent], PRIO(heap, parent));
+        j = parent;
+    }
+
+    dheap_set(heap, j, k, v);
+}
+
+/**
+ * @brief Move key k with priority v down from slot j to its place.
+ *        All d children are compared at once by min_child()
+ */
+static
+void dheap_sift_down(dheap_t* heap, int j, int k, int v)
+{
+    int d = heap->d;
+    int n = heap->ctr;
+
+    for(;;)
+    {
+        int first = d * j + 1;
+
+        if(first >= n)
+            break;
+
+        int c = first + heap->min_child(&PRIO(heap, first));
+
+        if(PRIO(heap, c) >= v)
+            break;
+
+        dheap_set(heap, j, heap->key[c], PRIO(heap, c));
+        j = c;
+    }
+
+    dheap_set(heap, j, k, v);
+}
+
+bool dheap_insert(dheap_t* heap, int k, int v)
+{
+    //keys are distinct and in [0,size), so the heap is never full for a valid key
+    if(k < 0 || k >= heap->size || heap->pos[k] >= 0)
+        return false;
+
+    dheap_sift_up(heap, heap->ctr++, k, v);
+
+    return true;
+}
+
+void dheap_decrease_key(dheap_t* heap, int k, int v)
+{
+    if(!dheap_contains(heap, k))
+        return;
+
+    dheap_sift_up(heap, heap->pos[k], k, v);
+}
+
+int dheap_min(const dheap_t* heap, key_value_t* pair)
+{
+    if(heap->ctr <= 0)
+        return 0;
+
+    pair->key = heap->key[0];
+    pair->value = PRIO(heap, 0);
+
+    return 1;
+}
+
+int dheap_extract_min(dheap_t* heap, key_value_t* pair)
+{
+    int last;
+
+    if(heap->ctr <= 0)
+        return 0;
+
+    pair->key = heap->key[0];
+    pair->value = PRIO(heap, 0);
+    heap->pos[pair->key] = -1;
+
+    last = --heap->ctr;
+    if(last == 0)
+    {
+        PRIO(heap, 0) = INT_MAX;
+        return 1;
+    }
+
+    int k = heap->key[last];
+    int v = PRIO(heap, last);
+
+    //keep the padding after the last item
+    PRIO(heap, last) = INT_MAX;
+
+    dheap_sift_down(heap, 0, k, v);
+
+    return 1;
+}
+
+bool dheap_contains(dheap_t* heap, int k)
+{
+    return k >= 0 && k < heap->size && heap->pos[k] >= 0;
+}
+
+void dheap_clear(dheap_t* heap)
+{
+    for(int j = 0; j < heap->ctr; j++)
+    {
+        heap->pos[heap->key[j]] = -1;
+
+        //restore the padding read by min_child()
+        PRIO(heap, j) = INT_MAX;
+    }
+
+    heap->ctr = 0;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file    edgelist.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../inc/edgelist.h"
+#include "../inc/sortnet.h"
+#include "../inc/threadpool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EDGELIST_X86
+#include <immintrin.h>
+
+#define AVX2    __attribute__((target("avx2")))
+#endif
+
+// fewest edges worth a block of their own in a Bellman-Ford pass
+#define EDGELIST_GRAIN  4096
+
+/*
+ * Relax edges [lo,hi) from the costs in cur into next, which starts each pass as
+ * a copy of cur. Returns true if any cost in next went down
+ */
+typedef bool (*el_relax_fn)(const edge_list_t* el, int lo, int hi, const int* cur, int* next, int* prev);
+
+/**
+ * @brief State of a Bellman-Ford run shared by the blocks of a pass
+ *
+ */
+typedef struct el_bf_s
+{
+    const edge_list_t*  el;
+    el_relax_fn         relax;
+    int*                cur;        // costs after the previous pass
+    int*                next;       // costs being computed
+    int*                prev;
+    int*                bound;      // first destination of each block, nblocks + 1 entries
+    bool*               changed;    // whether each block lowered a cost in this pass
+
+}el_bf_t;
+
+static
+bool scalar_relax(const edge_list_t* el, int lo, int hi, const int* cur, int* next, int* prev)
+{
+    bool changed = false;
+
+    for(int i = lo; i < hi; i++)
+    {
+        int cu = cur[el->src[i]];
+        int v = el->dst[i];
+
+        //unreached, INT_MAX + w would overflow
+        if(cu != INT_MAX && cu + el->weight[i] < next[v])
+        {
+            next[v] = cu + el->weight[i];
+            prev[v] = el->src[i];
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+#ifdef EDGELIST_X86
+
+AVX2 static
+bool avx2_relax(const edge_list_t* el, int lo, int hi, const int* cur, int* next, int* prev)
+{
+    const __m256i inf = _mm256_set1_epi32(INT_MAX);
+    bool changed = false;
+    int i = lo;
+
+    for(; i + 8 <= hi; i += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(el->src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(el->dst + i));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(el->weight + i));
+        __m256i cu = _mm256_i32gather_epi32(cur, s, 4);
+        __m256i cv = _mm256_i32gather_epi32(next, d, 4);
+        __m256i c = _mm256_add_epi32(cu, w);
+
+        //lanes of reached sources that improve on their destination
+        __m256i hit = _mm256_andnot_si256(_mm256_cmpeq_epi32(cu, inf), _mm256_cmpgt_epi32(cv, c));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(hit));
+
+        if(mask)
+        {
+            int cost[8];
+
+            _mm256_storeu_si256((__m256i*)cost, c);
+
+            //lanes can share a destination, so each hit is checked again as it is written
+            while(mask)
+            {
+                int j = __builtin_ctz(mask);
+                int v = el->dst[i + j];
+
+                if(cost[j] < next[v])
+                {
+                    next[v] = cost[j];
+                    prev[v] = el->src[i + j];
+                }
+
+                mask &= mask - 1;
+            }
+
+            changed = true;
+        }
+    }
+
+    return scalar_relax(el, i, hi, cur, next, prev) || changed;
+}
+
+#endif //EDGELIST_X86
+
+edge_list_t* edge_list_from_graph(graph_t* g)
+{
+    edge_list_t* el = malloc(sizeof(edge_list_t));
+    struct node* tmp;
+    int* slot;
+    int ne = 0;
+
+    el->nv = g->nv;
+    el->first = (int*)calloc(g->nv + 1, sizeof(int));
+
+    //count the in-degree of each vertex, one slot ahead
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            el->first[tmp->v + 1]++;
+            ne++;
+        }
+    }
+
+    for(int v = 0; v < g->nv; v++)
+        el->first[v + 1] += el->first[v];
+
+    el->ne = ne;
+    el->src = (int*)malloc(ne * sizeof(int));
+    el->dst = (int*)malloc(ne * sizeof(int));
+    el->weight = (int*)malloc(ne * sizeof(int));
+
+    //scatter each edge to the next free slot of its destination
+    slot = malloc(g->nv * sizeof(int));
+    memcpy(slot, el->first, g->nv * sizeof(int));
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            int i = slot[tmp->v]++;
+
+            el->src[i] = u;
+            el->dst[i] = tmp->v;
+            el->weight[i] = tmp->w;
+        }
+    }
+
+    free(slot);
+    return el;
+}
+
+void edge_list_destroy(edge_list_t* el)
+{
+    if(el == NULL)
+        return;
+
+    free(el->first);
+    free(el->src);
+    free(el->dst);
+    free(el->weight);
+    free(el);
+}
+
+/**
+ * @brief One pass over the destinations of blocks [lo,hi)
+ */
+static
+void el_bf_pass(int lo, int hi, void* ctx)
+{
+    el_bf_t* bf = ctx;
+
+    for(int k = lo; k < hi; k++)
+    {
+        int vlo = bf->bound[k];
+        int vhi = bf->bound[k + 1];
+
+        memcpy(bf->next + vlo, bf->cur + vlo, (vhi - vlo) * sizeof(int));
+        bf->changed[k] = bf->relax(bf->el, bf->el->first[vlo], bf->el->first[vhi], bf->cur, bf->next, bf->prev);
+    }
+}
+
+sssp_t* edge_list_bellman_ford(edge_list_t* el, int src, int nthreads)
+{
+    sssp_t* sssp = malloc(sizeof(sssp_t));
+    pool_t* pool = pool_create(nthreads);
+    bool changed = true;
+    int nblocks;
+    el_bf_t bf;
+
+    bf.el = el;
+    bf.relax = scalar_relax;
+#ifdef EDGELIST_X86
+    if(simd_level() >= SIMD_AVX2)
+        bf.relax = avx2_relax;
+#endif
+
+    nblocks = (el->ne + EDGELIST_GRAIN - 1) / EDGELIST_GRAIN;
+    if(nblocks > 4 * pool->nthreads)
+        nblocks = 4 * pool->nthreads;
+    if(nblocks < 1)
+        nblocks = 1;
+
+    //destination ranges with about ne / nblocks edges each
+    bf.bound = malloc((nblocks + 1) * sizeof(int));
+    bf.changed = malloc(nblocks * sizeof(bool));
+    for(int k = 0, v = 0; k < nblocks; k++)
+    {
+        long long target = (long long)el->ne * k / nblocks;
+
+        while(el->first[v] < target)
+            v++;
+
+        bf.bound[k] = v;
+    }
+    bf.bound[nblocks] = el->nv;
+
+    bf.cur = (int*)malloc(el->nv * sizeof(int));
+    bf.next = (int*)malloc(el->nv * sizeof(int));
+    bf.prev = (int*)malloc(el->nv * sizeof(int));
+
+    for(int j=0; j < el->nv; j++)
+    {
+        bf.cur[j] = INT_MAX;
+        bf.prev[j] = -1;
+    }
+    bf.cur[src] = 0;
+
+    //without negative cycles, costs settle within nv - 1 passes and pass nv is quiet
+    for(int i = 0; i < el->nv && changed; i++)
+    {
+        int* tmp;
+
+        pool_parallel_for(pool, nblocks, 1, el_bf_pass, &bf);
+
+        changed = false;
+        for(int k = 0; k < nblocks; k++)
+            changed |= bf.changed[k];
+
+        tmp = bf.cur;
+        bf.cur = bf.next;
+        bf.next = tmp;
+    }
+
+    free(bf.next);
+    free(bf.bound);
+    free(bf.changed);
+    pool_destroy(pool);
+
+    if(changed)
+    {
+        free(bf.cur);
+        free(bf.prev);
+        free(sssp);
+
+        return NULL;
+    }
+
+    sssp->cost = bf.cur;
+    sssp->prev = bf.prev;
+
+    return sssp;
+}
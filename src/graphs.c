@@ -13,6 +13,12 @@
 #include "../inc/graphs.h"
 #include "../inc/queue.h"
 #include "../inc/heap.h"
+#include "../inc/dheap.h"
+#include "../inc/monoqueue.h"
+
+// nodes in the first arena chunk of a graph, doubled for each new chunk up to NODE_CHUNK_MAX
+#define NODE_CHUNK_MIN      256
+#define NODE_CHUNK_MAX      65536
 
 /**
  * @brief Create a graph object
@@ -27,37 +33,63 @@ graph_t* create_graph(int nv, bool dir)
 
     g->dir = dir;
     g->nv = nv;
-    g->adj = calloc(nv, sizeof(struct node));
+    g->adj = calloc(nv, sizeof(struct node*));
+    g->chunks = NULL;
+    g->free_nodes = NULL;
 
     return g;
 }
 
+void destroy_graph(graph_t* g)
+{
+    struct node_chunk* c = g->chunks;
+
+    while(c)
+    {
+        struct node_chunk* next = c->next;
+
+        free(c);
+        c = next;
+    }
+
+    free(g->adj);
+    free(g);
+}
+
 /**
- * @brief recursively deallocate nodes in an adjacency list
+ * @brief Take a node from the graph arena. Nodes released by remove_edge are 
+ *        reused first, then nodes are handed out in order from the newest chunk
  * 
- * @param n first node in the linked list of adjacencies
+ * @param g pointer to graph
+ * @return struct node* 
  */
 static
-void dealloc_node(struct node* n)
+struct node* alloc_node(graph_t* g)
 {
+    struct node_chunk* c = g->chunks;
+    struct node* n = g->free_nodes;
+
     if(n)
     {
-        dealloc_node(n->next);
-        free(n);
+        g->free_nodes = n->next;
+        return n;
     }
-}
 
-void destroy_graph(graph_t* g)
-{
-    for (int v = 0; v < g->nv; v++) 
+    if(c == NULL || c->used == c->cap)
     {
-        struct node* tmp = g->adj[v];
+        int cap = c ? 2 * c->cap : NODE_CHUNK_MIN;
+
+        if(cap > NODE_CHUNK_MAX)
+            cap = NODE_CHUNK_MAX;
 
-        dealloc_node(tmp);
+        c = malloc(sizeof(struct node_chunk) + cap * sizeof(struct node));
+        c->next = g->chunks;
+        c->used = 0;
+        c->cap = cap;
+        g->chunks = c;
     }
 
-    free(g->adj);
-    free(g);
+    return &c->nodes[c->used++];
 }
     
 /**
@@ -75,7 +107,7 @@ void add_edge(graph_t* g, int src, int dst, int w)
     if(g == (void*)0)
         return;
 
-    struct node* node = malloc(sizeof(struct node));
+    struct node* node = alloc_node(g);
     node->v = dst;
     node->w = w;
     node->next = g->adj[src];
@@ -83,7 +115,7 @@ void add_edge(graph_t* g, int src, int dst, int w)
 
     if(!g->dir)
     {
-        struct node* dir_node = malloc(sizeof(struct node));
+        struct node* dir_node = alloc_node(g);
         dir_node->v = src;
         dir_node->w = w;
         dir_node->next = g->adj[dst];
@@ -91,6 +123,51 @@ void add_edge(graph_t* g, int src, int dst, int w)
     }
 }
 
+/**
+ * @brief Unlink the first node to dst from the adjacency list of src 
+ *        and put it on the free list of the arena
+ */
+static
+bool unlink_node(graph_t* g, int src, int dst)
+{
+    struct node** link = &g->adj[src];
+
+    while(*link && (*link)->v != dst)
+        link = &(*link)->next;
+
+    if(*link == NULL)
+        return false;
+
+    struct node* n = *link;
+    *link = n->next;
+
+    n->next = g->free_nodes;
+    g->free_nodes = n;
+
+    return true;
+}
+
+/**
+ * @brief Remove an edge from a graph. 
+ * If graph is not directed this function will
+ * also remove the edge from dst to src. The nodes are kept for reuse by add_edge.
+ * 
+ * @param g pointer to graph
+ * @param src source vertex
+ * @param dst destination vertex
+ * @return true if an edge was removed, false if there was no edge from src to dst
+ */
+bool remove_edge(graph_t* g, int src, int dst)
+{
+    if(g == NULL || !unlink_node(g, src, dst))
+        return false;
+
+    if(!g->dir)
+        unlink_node(g, dst, src);
+
+    return true;
+}
+
 /**
  * @brief Add a vertex to a graph
  * 
@@ -115,6 +192,27 @@ void add_vertex(graph_t* g)
     free(adj);
 }
 
+/**
+ * @brief Build the transpose of a graph, where each edge u -> v becomes v -> u
+ * 
+ * @param g pointer to graph
+ * @return graph_t* 
+ */
+graph_t* transpose_graph(graph_t* g)
+{
+    //every stored edge is added one way, undirected graphs already hold both
+    graph_t* t = create_graph(g->nv, DIRECTED);
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(struct node* tmp = g->adj[u]; tmp; tmp = tmp->next)
+            add_edge(t, tmp->v, u, tmp->w);
+    }
+
+    t->dir = g->dir;
+    return t;
+}
+
 /**
  * @brief Print a graph in adjacency list representation
  * 
@@ -147,7 +245,6 @@ void print_graph(graph_t* g)
  */
 sssp_t* bfs(graph_t* g, int src)
 {
-    bool visited[g->nv];
     int u;
     struct node* tmp;
     queue_t q;
@@ -161,11 +258,9 @@ sssp_t* bfs(graph_t* g, int src)
     {
         sssp->cost[j] = INT_MAX;
         sssp->prev[j] = -1;
-        visited[j] = false;
     }
 
     queue(&q,g->nv);
-    visited[src] = true;
     sssp->cost[src] = 0;
 
     enqueue(&q,src);
@@ -175,9 +270,9 @@ sssp_t* bfs(graph_t* g, int src)
         tmp = g->adj[u];
         while(tmp)
         {
-            if(visited[tmp->v] == false)
+            //unvisited vertices still have an infinite cost
+            if(sssp->cost[tmp->v] == INT_MAX)
             {
-                visited[tmp->v] = true;
                 sssp->cost[tmp->v] = sssp->cost[u] + 1;
                 sssp->prev[tmp->v] = u;
                 enqueue(&q,tmp->v);
@@ -225,6 +320,149 @@ void print_shortest_path(sssp_t* sssp, int src , int dst)
 }
 
 
+/**
+ * @brief Priority queue used by Dijkstra's algorithm, one of the PQ_* structures.
+ *        A vertex enters the queue when it is first relaxed, so vertices that are 
+ *        never reached cost nothing. Monotone queues have no decrease-key: 
+ *        a vertex is inserted again each time its cost drops
+ * 
+ */
+typedef struct pq_s
+{
+    int         type;
+    heap_t*     heap;
+    dheap_t*    dheap;
+    rheap_t*    rheap;
+    bucketq_t*  bucketq;
+
+}pq_t;
+
+/**
+ * @brief Largest edge weight of a graph, -1 if it has no edges
+ */
+static
+int max_weight(graph_t* g)
+{
+    struct node* tmp;
+    int c = -1;
+
+    for(int u = 0; u < g->nv; u++)
+    {
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            if(tmp->w > c)
+                c = tmp->w;
+        }
+    }
+
+    return c;
+}
+
+static
+void pq_create(pq_t* pq, int type, graph_t* g)
+{
+    int c;
+
+    memset(pq, 0, sizeof(pq_t));
+    pq->type = type;
+
+    switch(type)
+    {
+        case PQ_DARY_HEAP:
+            pq->dheap = dheap_create(g->nv, DARY_HEAP_ARITY);
+        break;
+
+        case PQ_BUCKET_QUEUE:
+            c = max_weight(g);
+            if(c <= BUCKET_QUEUE_MAX_WEIGHT)
+            {
+                pq->bucketq = bucketq_create(c < 0 ? 0 : c);
+                break;
+            }
+            //too many buckets for the largest weight, fall back on a radix heap
+            pq->type = PQ_RADIX_HEAP;
+            /* fall through */
+
+        case PQ_RADIX_HEAP:
+            pq->rheap = rheap_create();
+        break;
+
+        default:
+            pq->type = PQ_BINARY_HEAP;
+            pq->heap = indexed_min_heap(g->nv);
+        break;
+    }
+}
+
+static
+void pq_destroy(pq_t* pq)
+{
+    destroy_heap(pq->heap);
+    dheap_destroy(pq->dheap);
+    rheap_destroy(pq->rheap);
+    bucketq_destroy(pq->bucketq);
+}
+
+/**
+ * @brief Insert key k with priority v
+ *
+ * @return false if the queue rejected the item
+ */
+static inline
+bool pq_insert(pq_t* pq, int k, int v)
+{
+    switch(pq->type)
+    {
+        case PQ_DARY_HEAP:      return dheap_insert(pq->dheap, k, v);
+        case PQ_BUCKET_QUEUE:   return bucketq_insert(pq->bucketq, k, v);
+        case PQ_RADIX_HEAP:     return rheap_insert(pq->rheap, k, v);
+        default:                return min_insert(pq->heap, k, v);
+    }
+}
+
+/**
+ * @brief Lower the priority of k to v, inserting k if this is its first relaxation
+ *
+ * @return false if the queue rejected the item
+ */
+static inline
+bool pq_relax(pq_t* pq, int k, int v, bool first)
+{
+    switch(pq->type)
+    {
+        case PQ_DARY_HEAP:
+            if(first)
+                return dheap_insert(pq->dheap, k, v);
+
+            dheap_decrease_key(pq->dheap, k, v);
+        break;
+
+        case PQ_BINARY_HEAP:
+            if(first)
+                return min_insert(pq->heap, k, v);
+
+            min_decrease_key(pq->heap, k, v);
+        break;
+
+        default:
+            return pq_insert(pq, k, v);
+    }
+
+    return true;
+}
+
+static inline
+int pq_extract_min(pq_t* pq, key_value_t* item)
+{
+    switch(pq->type)
+    {
+        case PQ_DARY_HEAP:      return dheap_extract_min(pq->dheap, item);
+        case PQ_RADIX_HEAP:     return rheap_extract_min(pq->rheap, item);
+        case PQ_BUCKET_QUEUE:   return bucketq_extract_min(pq->bucketq, item);
+        default:                return extract_min(pq->heap, item);
+    }
+}
+
 /**
  * @brief Finds the shortest path from node src to node dst in a positively weighted directed graph
  * using Dijkstras algorithm
@@ -235,10 +473,22 @@ void print_shortest_path(sssp_t* sssp, int src , int dst)
  */
 sssp_t* dijkstra(graph_t* g, int src)
 {
-    heap_t* heap;
+    return dijkstra_with(g, src, PQ_BINARY_HEAP);
+}
+
+/**
+ * @brief Dijkstra's algorithm that stops as soon as dst is settled, or builds 
+ *        the whole tree if dst is -1. Once stopped, only the costs and parents 
+ *        on the path to dst are final
+ */
+static
+sssp_t* dijkstra_until(graph_t* g, int src, int dst, int pq)
+{
+    pq_t queue;
     key_value_t item;
     struct node* tmp;
-    int u,i;
+    bool ok;
+    int u;
 
     sssp_t* sssp = malloc(sizeof(sssp_t));
 
@@ -252,19 +502,21 @@ sssp_t* dijkstra(graph_t* g, int src)
     }
     sssp->cost[src] = 0;
 
-    heap = min_heap(g->nv);    
-    for(int j=0; j < g->nv; j++)
-    {
-        min_insert(heap, j, sssp->cost[j]);
-    }
+    pq_create(&queue, pq, g);
+    ok = pq_insert(&queue, src, 0);
 
-    while(heap->ctr != 0)
+    while(ok && pq_extract_min(&queue, &item))
     {
-        if(extract_min(heap, &item) == 0)
-        {
-            return NULL;
-        }
         u = item.key;
+
+        //stale copy of a vertex that was settled with a lower cost
+        if(item.value > sssp->cost[u])
+            continue;
+
+        //settled, nothing left in the queue can lower its cost
+        if(u == dst)
+            break;
+
         tmp = g->adj[u];
 
         //for each vertex v ∈ G.Adj[u]
@@ -273,22 +525,54 @@ sssp_t* dijkstra(graph_t* g, int src)
             //relax
             if(sssp->cost[u] + tmp->w < sssp->cost[tmp->v])
             {
+                bool first = sssp->cost[tmp->v] == INT_MAX;
+
                 sssp->cost[tmp->v] = sssp->cost[u] + tmp->w ;
                 sssp->prev[tmp->v] = u;
-                min_decrease_key(heap, tmp->v,sssp->cost[tmp->v]);
+
+                //a dropped vertex would silently keep a wrong cost
+                if(!pq_relax(&queue, tmp->v, sssp->cost[tmp->v], first))
+                {
+                    ok = false;
+                    break;
+                }
             }
 
             tmp = tmp->next;
         }
     }
 
+    pq_destroy(&queue);
+
+    if(!ok)
+    {
+        free(sssp->cost);
+        free(sssp->prev);
+        free(sssp);
+
+        return NULL;
+    }
+
     return sssp;
 }
 
+/**
+ * @brief Dijkstra's algorithm with a choice of priority queue
+ * 
+ * @param g pointer to graph
+ * @param src source node
+ * @param pq priority queue to use. Options: PQ_BINARY_HEAP, PQ_DARY_HEAP, PQ_RADIX_HEAP, PQ_BUCKET_QUEUE
+ * @return sssp_t*, NULL if the queue rejected a vertex
+ */
+sssp_t* dijkstra_with(graph_t* g, int src, int pq)
+{
+    return dijkstra_until(g, src, -1, pq);
+}
+
 
 /**
  * @brief Finds the shortest path from node src to node dst in a weighted directed graph
- * using Bellman-Ford's algorithm
+ * using Bellman-Ford's algorithm. Passes stop early once no cost changes
  * 
  * @param g pointer to graph
  * @param src source node
@@ -297,6 +581,7 @@ sssp_t* dijkstra(graph_t* g, int src)
 sssp_t* bellman_ford(graph_t* g, int src)
 {
     struct node* tmp;
+    bool changed = true;
     sssp_t* sssp = malloc(sizeof(sssp_t));
     sssp->cost = (int*)malloc(g->nv * sizeof(int));
     sssp->prev = (int*)malloc(g->nv * sizeof(int));
@@ -310,12 +595,17 @@ sssp_t* bellman_ford(graph_t* g, int src)
     sssp->cost[src] = 0;
 
 
-    for(int i=0; i < g->nv; i++)
+    for(int i=0; i < g->nv && changed; i++)
     {
+        changed = false;
 
         //foreach (u,v) ∈ E
         for(int u = 0; u < g->nv; u++)
         {
+            //unreached, INT_MAX + w would overflow
+            if(sssp->cost[u] == INT_MAX)
+                continue;
+
             tmp = g->adj[u];
             while(tmp)
             {
@@ -324,6 +614,7 @@ sssp_t* bellman_ford(graph_t* g, int src)
                 {
                     sssp->cost[tmp->v] = sssp->cost[u] + tmp->w ;
                     sssp->prev[tmp->v] = u;
+                    changed = true;
                 }
 
                 tmp = tmp->next;
@@ -331,9 +622,16 @@ sssp_t* bellman_ford(graph_t* g, int src)
         }
     }
 
+    //a quiet pass means every cost is final
+    if(!changed)
+        return sssp;
+
     //foreach (u,v) ∈ E
     for(int u = 0; u < g->nv; u++)
     {
+        if(sssp->cost[u] == INT_MAX)
+            continue;
+
         tmp = g->adj[u];
         while(tmp)
         {
@@ -354,6 +652,188 @@ sssp_t* bellman_ford(graph_t* g, int src)
     return sssp;
 }
 
+/**
+ * @brief Shortest path tree kept as a list in preorder, so the subtree of v is v 
+ *        followed by the nodes deeper than v. Vertices out of the tree have depth -1
+ * 
+ */
+typedef struct spt_s
+{
+    int* succ;              // next vertex in preorder, -1 for the last
+    int* pred;              // previous vertex in preorder, -1 for the root
+    int* depth;
+
+}spt_t;
+
+/**
+ * @brief Take the subtree of v out of the tree
+ * 
+ * @return true if u is in the subtree, so the edge (u,v) closes a cycle
+ */
+static
+bool spt_cut(spt_t* t, int v, int u)
+{
+    int x = t->succ[v];
+
+    if(t->depth[v] < 0)
+        return false;
+
+    if(u == v)
+        return true;
+
+    while(x != -1 && t->depth[x] > t->depth[v])
+    {
+        if(x == u)
+            return true;
+
+        t->depth[x] = -1;
+        x = t->succ[x];
+    }
+
+    t->depth[v] = -1;
+    if(t->pred[v] != -1)
+        t->succ[t->pred[v]] = x;
+    if(x != -1)
+        t->pred[x] = t->pred[v];
+
+    return false;
+}
+
+/**
+ * @brief Insert v in the tree as the first child of u
+ */
+static
+void spt_link(spt_t* t, int v, int u)
+{
+    t->succ[v] = t->succ[u];
+    t->pred[v] = u;
+    if(t->succ[u] != -1)
+        t->pred[t->succ[u]] = v;
+    t->succ[u] = v;
+    t->depth[v] = t->depth[u] + 1;
+}
+
+/**
+ * @brief Cycle closed by the edge (u,v), from v down the tree to u
+ */
+static
+void spt_cycle(sssp_t* sssp, int v, int u, path_t* cycle)
+{
+    int n = 1;
+
+    for(int x = u; x != v; x = sssp->prev[x])
+        n++;
+
+    cycle->v = (int*)malloc(n * sizeof(int));
+    cycle->n = n;
+
+    for(int x = u; n--; x = sssp->prev[x])
+        cycle->v[n] = x;
+}
+
+/**
+ * @brief Queue-based Bellman-Ford (SPFA) with Tarjan's subtree disassembly
+ * 
+ * @param g pointer to graph
+ * @param src source node
+ * @param cycle if not NULL, receives the negative cycle when one is found (cycle->v must be freed), 
+ *        or an empty path otherwise
+ * @return An sssp object if no negative cycles are found, NULL if a negative cycle is found 
+ */
+sssp_t* spfa(graph_t* g, int src, path_t* cycle)
+{
+    struct node* tmp;
+    queue_t q;
+    spt_t t;
+    bool* inq = (bool*)calloc(g->nv, sizeof(bool));
+    bool found = false;
+    int u;
+
+    sssp_t* sssp = malloc(sizeof(sssp_t));
+    sssp->cost = (int*)malloc(g->nv * sizeof(int));
+    sssp->prev = (int*)malloc(g->nv * sizeof(int));
+
+    t.succ = (int*)malloc(g->nv * sizeof(int));
+    t.pred = (int*)malloc(g->nv * sizeof(int));
+    t.depth = (int*)malloc(g->nv * sizeof(int));
+
+    for(int j=0; j < g->nv; j++)
+    {
+        sssp->cost[j] = INT_MAX;
+        sssp->prev[j] = -1;
+        t.depth[j] = -1;
+    }
+
+    if(cycle)
+    {
+        cycle->v = NULL;
+        cycle->n = 0;
+    }
+
+    sssp->cost[src] = 0;
+    t.succ[src] = -1;
+    t.pred[src] = -1;
+    t.depth[src] = 0;
+
+    queue(&q, g->nv);
+    enqueue(&q, src);
+    inq[src] = true;
+
+    while(!found && dequeue(&q, &u))
+    {
+        inq[u] = false;
+
+        //cut out of the tree after it was queued, its cost will drop again
+        if(t.depth[u] < 0)
+            continue;
+
+        for(tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            int v = tmp->v;
+
+            //relax
+            if(sssp->cost[u] + tmp->w < sssp->cost[v])
+            {
+                if(spt_cut(&t, v, u))
+                {
+                    if(cycle)
+                        spt_cycle(sssp, v, u, cycle);
+
+                    found = true;
+                    break;
+                }
+
+                sssp->cost[v] = sssp->cost[u] + tmp->w;
+                sssp->prev[v] = u;
+                spt_link(&t, v, u);
+
+                if(!inq[v])
+                {
+                    enqueue(&q, v);
+                    inq[v] = true;
+                }
+            }
+        }
+    }
+
+    queue_delete(&q);
+    free(inq);
+    free(t.succ);
+    free(t.pred);
+    free(t.depth);
+
+    if(found)
+    {
+        free(sssp->cost);
+        free(sssp->prev);
+        free(sssp);
+
+        return NULL;
+    }
+
+    return sssp;
+}
+
 
 /**
  * @brief Prints the shortest path between two nodes in a graph
@@ -361,8 +841,10 @@ sssp_t* bellman_ford(graph_t* g, int src)
  * @param g pointer to graph
  * @param src source node
  * @param dst destination node
- * @param algo algorithm to use. Options: USE_BFS (only unweighted graphs), USE_DIJKSTRA, USE_BELLMAN_FORD
-
+ * @param algo algorithm to use. Options: USE_BFS (only unweighted graphs), USE_DIJKSTRA, USE_BELLMAN_FORD,
+ *        USE_DELTA_STEPPING (non-negative weights), USE_SPFA. USE_DIJKSTRA stops once dst is settled,
+ *        the others build the whole shortest path tree from src; for repeated point-to-point
+ *        queries reuse a p2p_t from p2p.h instead
  * @return TRUE if successful, FALSE if failed
  */
 bool shortest_path(graph_t* g, int src , int dst, int algo)
@@ -381,8 +863,29 @@ bool shortest_path(graph_t* g, int src , int dst, int algo)
         break;
         
         case USE_DIJKSTRA:
-            sssp = dijkstra(g, src);
+            sssp = dijkstra_until(g, src, dst, PQ_BINARY_HEAP);
+        break;
+
+        case USE_DELTA_STEPPING:
+            sssp = delta_stepping(g, src, 0, 0);
         break;
+
+        case USE_SPFA:
+        {
+            path_t cycle;
+
+            sssp = spfa(g, src, &cycle);
+            if(cycle.n)
+            {
+                printf("negative cycle: ");
+                for(int i = 0; i < cycle.n; i++)
+                    printf("%d -> ", cycle.v[i]);
+                printf("%d \n", cycle.v[0]);
+            }
+            free(cycle.v);
+        }
+        break;
+
     }
 
     if(sssp == NULL)
@@ -10,132 +10,629 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <stdbool.h>
 #include "../inc/heap.h"
+#include "../inc/sort.h"
 
 
 
-heap_t* min_heap(int size)
+/**
+ * @brief Create an empty heap
+ * 
+ * @param size initial capacity, the heap grows as needed
+ * @param type MIN_HEAP or MAX_HEAP
+ * @return heap_t*, NULL if the memory could not be allocated
+ */
+heap_t* heap_create(int size, int type)
 {
     heap_t* heap = (heap_t*)malloc(sizeof(heap_t));
-    heap->size = size;
+
+    if(heap == NULL)
+        return NULL;
+
+    heap->size = size > 0 ? size : 1;
     heap->ctr = 0;
-    heap->pair = (key_value_t*)malloc(size * sizeof(key_value_t));
+    heap->type = type;
+    heap->pos = NULL;
+    heap->nkeys = 0;
+    heap->pair = (key_value_t*)malloc(heap->size * sizeof(key_value_t));
 
-    for(int i=0; i < size; i++)
+    if(heap->pair == NULL)
     {
-        heap->pair[i].value = INT_MAX;
-        heap->pair[i].key = 0;
-    }   
+        free(heap);
+        return NULL;
+    }
 
     return heap;
+}
+
+heap_t* min_heap(int size)
+{
+    return heap_create(size, MIN_HEAP);
+}
 
+heap_t* max_heap(int size)
+{
+    return heap_create(size, MAX_HEAP);
 }
 
 /**
- * @brief Corrects a violation of min heap where a child node 
- *        has smaller value than a parent node
+ * @brief Create a min heap indexed by key. A position map from key to heap slot 
+ *        is kept up to date on every move, so decrease-key, contains and delete 
+ *        run in O(logn) instead of scanning the heap
  * 
- * @param a pointer to min heap array 
- * @param n heap size
- * @param i parent node index
+ * @param size initial capacity, keys are expected in [0,size) but the map grows for bigger keys
+ * @return heap_t*, NULL if the memory could not be allocated
  */
-void min_heapify(heap_t* heap,int i)
+heap_t* indexed_min_heap(int size)
 {
-    int l = 2*i;
-    int r = 2*i + 1;
-    int min = i;
-    int n = heap->ctr;
-    key_value_t* a = heap->pair;
+    heap_t* heap = min_heap(size);
 
-    if(l < n && a[l].value < a[i].value)
-        min = l;
-    
-    if(r < n && a[r].value < a[min].value)
-        min = r;
-    
-    if(min == i)
+    if(heap == NULL)
+        return NULL;
+
+    heap->nkeys = heap->size;
+    heap->pos = (int*)malloc(heap->nkeys * sizeof(int));
+    if(heap->pos == NULL)
+    {
+        destroy_heap(heap);
+        return NULL;
+    }
+
+    for(int i=0; i < heap->nkeys; i++)
+    {
+        heap->pos[i] = -1;
+    }
+
+    return heap;
+}
+
+void destroy_heap(heap_t* heap)
+{
+    if(heap == NULL)
         return;
 
-    key_value_t aux = a[i];
-    a[i] = a[min];
-    a[min] = aux;
+    free(heap->pos);
+    free(heap->pair);
+    free(heap);
+}
 
-    min_heapify(heap, min);
+/**
+ * @brief Grow the capacity geometrically until n pairs fit
+ *
+ * @return false if the memory could not be allocated, the heap is left as it was
+ */
+static
+bool heap_reserve(heap_t* heap, int n)
+{
+    size_t size = heap->size;
+    key_value_t* pair;
+
+    if(n <= heap->size)
+        return true;
+
+    while(size < (size_t)n)
+        size *= 2;
+    if(size > INT_MAX)
+        size = INT_MAX;
+
+    pair = (key_value_t*)realloc(heap->pair, size * sizeof(key_value_t));
+    if(pair == NULL)
+        return false;
+
+    heap->pair = pair;
+    heap->size = (int)size;
+
+    return true;
 }
 
-void min_insert(heap_t* heap, int k, int v)
+/**
+ * @brief Grow the position map geometrically until key k fits
+ *
+ * @return false if the memory could not be allocated, the map is left as it was
+ */
+static
+bool heap_reserve_key(heap_t* heap, int k)
 {
-    key_value_t aux;
+    size_t nkeys = heap->nkeys;
+    int* pos;
 
-    if (heap->size == heap->ctr)
+    if(k < heap->nkeys)
+        return true;
+
+    while(nkeys <= (size_t)k)
+        nkeys *= 2;
+    if(nkeys > INT_MAX)
+        nkeys = INT_MAX;
+
+    pos = (int*)realloc(heap->pos, nkeys * sizeof(int));
+    if(pos == NULL)
+        return false;
+
+    for(size_t i = heap->nkeys; i < nkeys; i++)
+        pos[i] = -1;
+    heap->pos = pos;
+    heap->nkeys = (int)nkeys;
+
+    return true;
+}
+
+/**
+ * @brief Place a pair on slot i, recording its new position
+ */
+static inline
+void heap_set(heap_t* heap, int i, key_value_t item)
+{
+    heap->pair[i] = item;
+
+    if(heap->pos)
+        heap->pos[item.key] = i;
+}
+
+/**
+ * @brief True if value x belongs above value y: x < y on a min heap, x > y on a max heap.
+ *        max is a constant at every call, so each sift below compiles to its own 
+ *        comparison and the heap type is not tested inside the loops
+ */
+static inline
+bool heap_before(bool max, int x, int y)
+{
+    return max ? x > y : x < y;
+}
+
+/**
+ * @brief Move the pair on slot i up while it belongs above its parent
+ */
+static inline
+void sift_up_as(heap_t* heap, int i, bool max)
+{
+    key_value_t item = heap->pair[i];
+
+    while (i != 0 && heap_before(max, item.value, heap->pair[(i-1)/2].value))
     {
-        return;
+        heap_set(heap, i, heap->pair[(i-1)/2]);
+        i = (i-1)/2;
     }
-  
-    heap->ctr++;
-    int i = heap->ctr - 1;
-    heap->pair[i].key = k;
-    heap->pair[i].value = v;
-    
-    while (i != 0 && heap->pair[(i-1)/2].value > heap->pair[i].value)
+
+    heap_set(heap, i, item);
+}
+
+/**
+ * @brief Move the pair on slot i down while one of its children belongs above it
+ */
+static inline
+void sift_down_as(heap_t* heap, int i, bool max)
+{
+    int n = heap->ctr;
+    key_value_t* a = heap->pair;
+    key_value_t item = a[i];
+
+    for(;;)
     {
-        aux = heap->pair[i];
-        heap->pair[i] = heap->pair[(i-1)/2];
-        heap->pair[(i-1)/2] = aux;
+        int c = 2*i + 1;
 
-        i = (i-1)/2;
+        if(c >= n)
+            break;
+
+        if(c + 1 < n && heap_before(max, a[c+1].value, a[c].value))
+            c++;
+
+        if(!heap_before(max, a[c].value, item.value))
+            break;
+
+        heap_set(heap, i, a[c]);
+        i = c;
     }
 
+    heap_set(heap, i, item);
 }
 
-void min_decrease_key(heap_t* heap, int k, int v)
+static
+void sift_up_min(heap_t* heap, int i)
+{
+    sift_up_as(heap, i, false);
+}
+
+static
+void sift_up_max(heap_t* heap, int i)
+{
+    sift_up_as(heap, i, true);
+}
+
+static
+void sift_down_min(heap_t* heap, int i)
+{
+    sift_down_as(heap, i, false);
+}
+
+static
+void sift_down_max(heap_t* heap, int i)
+{
+    sift_down_as(heap, i, true);
+}
+
+/**
+ * @brief Sifts ordered by the heap type, chosen once per call
+ */
+static
+void sift_up(heap_t* heap, int i)
+{
+    if(heap->type == MAX_HEAP)
+        sift_up_max(heap, i);
+    else
+        sift_up_min(heap, i);
+}
+
+static
+void sift_down(heap_t* heap, int i)
+{
+    if(heap->type == MAX_HEAP)
+        sift_down_max(heap, i);
+    else
+        sift_down_min(heap, i);
+}
+
+/**
+ * @brief Restore the heap property on all ctr pairs in O(n), sifting down 
+ *        every parent from the last one to the root (Floyd)
+ */
+static
+void heap_rebuild(heap_t* heap)
+{
+    if(heap->pos)
+    {
+        for(int i = 0; i < heap->ctr; i++)
+            heap->pos[heap->pair[i].key] = i;
+    }
+
+    if(heap->type == MAX_HEAP)
+    {
+        for(int i = heap->ctr/2 - 1; i >= 0; i--)
+            sift_down_max(heap, i);
+    }
+    else
+    {
+        for(int i = heap->ctr/2 - 1; i >= 0; i--)
+            sift_down_min(heap, i);
+    }
+}
+
+/**
+ * @brief Build a heap from an array of pairs in O(n)
+ * 
+ * @param pairs array of pairs, copied to the heap
+ * @param n number of pairs
+ * @param type MIN_HEAP or MAX_HEAP
+ * @return heap_t*, NULL if the memory could not be allocated
+ */
+heap_t* heap_build(const key_value_t* pairs, int n, int type)
 {
-    key_value_t aux;
+    heap_t* heap = heap_create(n, type);
+
+    if(heap == NULL)
+        return NULL;
+
+    memcpy(heap->pair, pairs, n * sizeof(key_value_t));
+    heap->ctr = n;
+    heap_rebuild(heap);
+
+    return heap;
+}
+
+/**
+ * @brief Slot of a key in the heap, or -1 if it is not there
+ */
+static
+int heap_find(heap_t* heap, int k)
+{
+    if(heap->pos)
+        return (k >= 0 && k < heap->nkeys) ? heap->pos[k] : -1;
 
     for(int i=0; i < heap->ctr; i++)
     {
         if(heap->pair[i].key == k)
-        {
-            heap->pair[i].value = v;
-            while (i != 0 && heap->pair[(i-1)/2].value > heap->pair[i].value)
-            {
-                aux = heap->pair[i];
-                heap->pair[i] = heap->pair[(i-1)/2];
-                heap->pair[(i-1)/2] = aux;
-
-                i = (i-1)/2;
-            }
-            return;
-        }
+            return i;
     }
+
+    return -1;
 }
 
-int extract_min(heap_t* heap, key_value_t* pair)
+/**
+ * @brief Corrects a violation of min heap where a child node 
+ *        has smaller value than a parent node
+ * 
+ * @param heap pointer to heap
+ * @param i parent node index
+ */
+void min_heapify(heap_t* heap,int i)
 {
-    if (heap->ctr <= 0)
+    if(heap->type == MIN_HEAP)
+        sift_down_min(heap, i);
+}
+
+void max_heapify(heap_t* heap, int i)
+{
+    if(heap->type == MAX_HEAP)
+        sift_down_max(heap, i);
+}
+
+/**
+ * @brief Insert key k with value v, sifting it up min or max ordered
+ */
+static inline
+bool heap_insert_as(heap_t* heap, int k, int v, bool max)
+{
+    if(heap->pos && (k < 0 || !heap_reserve_key(heap, k)))
+        return false;
+
+    if(!heap_reserve(heap, heap->ctr + 1))
+        return false;
+
+    int i = heap->ctr++;
+    heap->pair[i].key = k;
+    heap->pair[i].value = v;
+    
+    sift_up_as(heap, i, max);
+
+    return true;
+}
+
+/**
+ * @brief Insert key k with value v
+ * 
+ * @param heap pointer to min heap
+ * @param k key, not negative if the heap is indexed
+ * @param v value
+ * @return false if the heap is not a min heap, k was rejected or the heap 
+ *         could not grow, the heap is left as it was
+ */
+bool min_insert(heap_t* heap, int k, int v)
+{
+    return heap->type == MIN_HEAP && heap_insert_as(heap, k, v, false);
+}
+
+bool max_insert(heap_t* heap, int k, int v)
+{
+    return heap->type == MAX_HEAP && heap_insert_as(heap, k, v, true);
+}
+
+void min_decrease_key(heap_t* heap, int k, int v)
+{
+    int i = heap->type == MIN_HEAP ? heap_find(heap, k) : -1;
+
+    if(i < 0)
+        return;
+
+    heap->pair[i].value = v;
+    sift_up_min(heap, i);
+}
+
+void max_increase_key(heap_t* heap, int k, int v)
+{
+    int i = heap->type == MAX_HEAP ? heap_find(heap, k) : -1;
+
+    if(i < 0)
+        return;
+
+    heap->pair[i].value = v;
+    sift_up_max(heap, i);
+}
+
+bool heap_contains(heap_t* heap, int k)
+{
+    return heap_find(heap, k) >= 0;
+}
+
+/**
+ * @brief Remove the pair with key k from the heap, wherever it is
+ * 
+ * @param heap pointer to heap
+ * @param k key to remove
+ * @return 1 if the key was removed, 0 if it was not in the heap 
+ */
+int heap_delete(heap_t* heap, int k)
+{
+    int i = heap_find(heap, k);
+
+    if(i < 0)
         return 0;
 
-    if (heap->ctr == 1)
-    {
-        heap->ctr--;
-        *pair = heap->pair[0];
+    if(heap->pos)
+        heap->pos[k] = -1;
+
+    heap->ctr--;
+    if(i == heap->ctr)
         return 1;
-    }
+
+    //the last pair fills the hole and may have to go either way
+    heap_set(heap, i, heap->pair[heap->ctr]);
+
+    if(i != 0 && heap_before(heap->type == MAX_HEAP, heap->pair[i].value, heap->pair[(i-1)/2].value))
+        sift_up(heap, i);
+    else
+        sift_down(heap, i);
+
+    return 1;
+}
+
+/**
+ * @brief Take the root out, moving the last pair down from the top min or max ordered
+ */
+static inline
+int heap_extract_as(heap_t* heap, key_value_t* pair, bool max)
+{
+    if (heap->ctr <= 0)
+        return 0;
 
     *pair = heap->pair[0];
-    heap->pair[0] = heap->pair[heap->ctr-1];
     heap->ctr--;
 
-    min_heapify(heap, 0);
+    if(heap->pos)
+        heap->pos[pair->key] = -1;
+
+    if (heap->ctr == 0)
+        return 1;
+
+    heap_set(heap, 0, heap->pair[heap->ctr]);
+
+    sift_down_as(heap, 0, max);
   
     return 1;
 }
 
+int extract_min(heap_t* heap, key_value_t* pair)
+{
+    return heap->type == MIN_HEAP ? heap_extract_as(heap, pair, false) : 0;
+}
+
+int extract_max(heap_t* heap, key_value_t* pair)
+{
+    return heap->type == MAX_HEAP ? heap_extract_as(heap, pair, true) : 0;
+}
+
+/**
+ * @brief Move every pair of heap b into heap a, leaving b empty. 
+ *        A few pairs are sifted up one by one, O(m log(n+m)); 
+ *        more than that and the whole heap is rebuilt in O(n+m)
+ * 
+ * @param a pointer to heap that receives the pairs
+ * @param b pointer to heap of the same type. If a is indexed, keys must not be in both heaps
+ * @return false if a could not grow or b has a negative key for an indexed a, both heaps are left as they were
+ */
+bool heap_meld(heap_t* a, heap_t* b)
+{
+    int n = a->ctr;
+    int m = b->ctr;
+    int lg = 0;
+    int kmax = -1;
+
+    if(m > INT_MAX - n)
+        return false;
+
+    //grow everything first, so that a failure leaves both heaps untouched
+    if(a->pos)
+    {
+        for(int i = 0; i < m; i++)
+        {
+            if(b->pair[i].key < 0)
+                return false;
+            if(b->pair[i].key > kmax)
+                kmax = b->pair[i].key;
+        }
+
+        if(!heap_reserve_key(a, kmax))
+            return false;
+    }
+
+    if(!heap_reserve(a, n + m))
+        return false;
+
+    for(int i = 0; i < m; i++)
+    {
+        key_value_t item = b->pair[i];
+
+        if(b->pos)
+            b->pos[item.key] = -1;
+
+        heap_set(a, n + i, item);
+    }
+    b->ctr = 0;
+
+    for(int x = n + m; x > 1; x >>= 1)
+        lg++;
+
+    if((long)m * lg < n + m)
+    {
+        for(int i = n; i < n + m; i++)
+        {
+            a->ctr = i + 1;
+            sift_up(a, i);
+        }
+    }
+    else
+    {
+        a->ctr = n + m;
+        heap_rebuild(a);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Create a streaming selection of the k items with smallest value
+ * 
+ * @param k number of items to keep
+ * @return topk_t* 
+ */
+topk_t* topk_create(int k)
+{
+    topk_t* t = malloc(sizeof(topk_t));
+
+    t->k = k;
+    t->heap = max_heap(k);
+
+    return t;
+}
+
+void topk_destroy(topk_t* t)
+{
+    if(t == NULL)
+        return;
+
+    destroy_heap(t->heap);
+    free(t);
+}
+
+/**
+ * @brief Offer an item to the selection in O(logk). 
+ *        The root of the max heap is the biggest value kept and the first to be evicted
+ * 
+ * @param t pointer to selection
+ * @param k item key
+ * @param v item value
+ */
+void topk_push(topk_t* t, int k, int v)
+{
+    heap_t* heap = t->heap;
+
+    if(t->k <= 0)
+        return;
+
+    if(heap->ctr < t->k)
+    {
+        max_insert(heap, k, v);
+        return;
+    }
+
+    if(v < heap->pair[0].value)
+    {
+        heap->pair[0].key = k;
+        heap->pair[0].value = v;
+        max_heapify(heap, 0);
+    }
+}
+
+/**
+ * @brief Copy the items kept so far to out, in ascending order of value
+ * 
+ * @param t pointer to selection
+ * @param out array of at least k pairs
+ * @return number of items written
+ */
+int topk_result(topk_t* t, key_value_t* out)
+{
+    int n = t->heap->ctr;
+
+    memcpy(out, t->heap->pair, n * sizeof(key_value_t));
+
+    radix_sort_kv(out, n);
+
+    return n;
+}
 
 void test_min_heap()
 {
     heap_t* heap;
-    key_value_t item;
 
     heap = min_heap(5);
 
@@ -145,8 +642,6 @@ void test_min_heap()
     min_insert(heap, 3, 1);
     min_insert(heap, 4, 20);
 
-    //extract_min(heap, &item);
-
     for(int i=0; i<heap->ctr; i++)
         printf("min: %d %d \n", heap->pair[i].key, heap->pair[i].value);
 
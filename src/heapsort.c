@@ -10,7 +10,11 @@
 
 /**
  * @brief Corrects a violation of max heap where a child node 
- *        has bigger value than a parent node
+ *        has bigger value than a parent node.
+ *        Uses Floyd's bottom-up strategy: the hole left at node i is first moved 
+ *        down to a leaf along the path of bigger children, with one comparison per level, 
+ *        and the displaced element then climbs back up to its place, which is usually 
+ *        close to the leaf. Children of node i are 2i+1 and 2i+2.
  * 
  * @param a pointer to max heap array 
  * @param n heap size
@@ -19,24 +23,30 @@
 static
 void fix_max_heap(int* a, int n, int i)
 {
-    int l = 2*i;
-    int r = 2*i + 1;
-    int max = i;
+    int x = a[i];
+    int j = i;
+    int c;
 
-    if(l < n && a[l] > a[i])
-        max = l;
-    
-    if(r < n && a[r] > a[max])
-        max = r;
-    
-    if(max == i)
-        return;
+    while((c = 2*j + 1) < n)
+    {
+        //the grandchildren are read on the next level down
+        if(2*c + 1 < n)
+            __builtin_prefetch(&a[2*c + 1]);
+
+        if(c + 1 < n && a[c+1] > a[c])
+            c++;
+
+        a[j] = a[c];
+        j = c;
+    }
 
-    register int aux = a[i];
-    a[i] = a[max];
-    a[max] = aux;
+    while(j > i && a[(j-1)/2] < x)
+    {
+        a[j] = a[(j-1)/2];
+        j = (j-1)/2;
+    }
 
-    fix_max_heap(a, n, max);
+    a[j] = x;
 }
 
 /**
@@ -48,15 +58,15 @@ void fix_max_heap(int* a, int n, int i)
 static
 void build_max_heap(int* a, int n)
 {
-    for(int i=n/2; i >= 0; i--)
+    for(int i=n/2 - 1; i >= 0; i--)
     {
         fix_max_heap(a,n,i);
     }
 }
 
 /**
- * @brief Recursively sort an array in ascending order with Θ(nlogn) time complexity
- *        using a heap data structure
+ * @brief Sort an array in ascending order with Θ(nlogn) time complexity
+ *        and O(1) extra memory using a heap data structure
  * 
  * @param a pointer to array to be sorted
  * @param n size of the array to be sorted
@@ -65,6 +75,9 @@ void heapsort(int* a, int n)
 {
     int aux;
 
+    if(a == NULL || n < 2)
+        return;
+
     build_max_heap(a,n);
 
     for (int i=n-1; i > 0; i--)
@@ -74,4 +87,4 @@ void heapsort(int* a, int n)
         a[i] = aux;
         fix_max_heap(a,i,0);
     }
-}
\ No newline at end of file
+}
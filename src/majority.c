@@ -21,14 +21,14 @@
 int majority(int* a, int p, int r)
 {
     if(p == r)
-        return a[p];
+        return p;
     
     int q = (r + p)/2;
 
     int e = majority(a,p,q);
     int d = majority(a,q+1,r);
 
-    if(e == d)
+    if(a[e] == a[d])
         return e;
     
     int ctr_e, ctr_d;
@@ -7,47 +7,100 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include "../inc/sort.h"
+#include "../inc/threadpool.h"
+#include "../inc/sortnet.h"
 
+// width of the runs sorted by a sorting network before the first merge pass
+#define MERGE_RUN       SORTNET_MAX
+
+// minimum number of elements sorted or merged by a single parallel task
+#define PARALLEL_GRAIN  16384
 
 /**
- * @brief Merge two ordered sub-arrays within an array.
+ * @brief Merge two ordered runs src[lo,...,mid-1] and src[mid,...,hi-1] into dst[lo,...,hi-1].
+ *        If the runs are already in order they are copied without comparisons.
  * 
- * @param a array containing the two ordered sub-arrays to be merged
- * @param p first index of left most sub-array
- * @param q last index of left most sub-array
- * @param r last index of right most sub-array
+ * @param src array containing the two ordered runs
+ * @param dst array to receive the merged run
+ * @param lo first index of left run
+ * @param mid first index of right run
+ * @param hi one past the last index of right run
  */
 static
-void merge(int* a, int p,int q,int r)
+void merge(const int* src, int* dst, int lo, int mid, int hi)
 {
+    if(mid >= hi || src[mid-1] <= src[mid])
+    {
+        memcpy(dst + lo, src + lo, (hi - lo) * sizeof(int));
+        return;
+    }
 
-    int i, j, k;
- 
-    int* b = malloc ((r-p+1) * sizeof (int));
-
-    //take the first ordered sub-array a[p,...,q]
-    for(k=p, i=0; k < q+1; k++)
-        b[i++] = a[k];
-    
-    //we invert the second ordered sub-array, a[q+1,...,r], to 
-    //avoid the need of sentinel value
-    for(k=r; k > q; k--)
-        b[i++] = a[k];
-        
-    //merge    
-    for (k=p, i=0, j=r-p; k <= r; k++)
+    sortnet_merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+}
+
+/**
+ * @brief Iteratively sort an array in ascending order with Θ(nlogn) time complexity.
+ *        Each pass merges pairs of runs from one buffer into the other, so no 
+ *        allocation or copy back happens between passes.
+ * 
+ * @param a array to be sorted
+ * @param n size of the array
+ * @param buf scratch buffer of at least n elements, or NULL to allocate one internally;
+ *        if that allocation fails the array is sorted in place by quicksort()
+ */
+void bottomup_mergesort(int* a, int n, int* buf)
+{
+    int *src, *dst, *tmp;
+    int* own = NULL;
+
+    if(a == NULL || n < 2)
+        return;
+
+    for(int lo = 0; lo < n; lo += MERGE_RUN)
+        sortnet_sort(a + lo, (lo + MERGE_RUN < n) ? MERGE_RUN : n - lo);
+
+    if(n <= MERGE_RUN)
+        return;
+
+    if(buf == NULL)
     {
-        if(b[i] < b[j])
-            a[k] = b[i++];
-        else
-            a[k] = b[j--]; 
+        own = malloc(n * sizeof(int));
+
+        //no scratch memory, finish in place
+        if(own == NULL)
+        {
+            quicksort(a, 0, n - 1);
+            return;
+        }
+        buf = own;
     }
 
-    free(b);
+    src = a;
+    dst = buf;
+    for(int w = MERGE_RUN; w < n; w *= 2)
+    {
+        for(int lo = 0; lo < n; lo += 2*w)
+        {
+            int mid = (lo + w < n) ? lo + w : n;
+            int hi = (lo + 2*w < n) ? lo + 2*w : n;
+            merge(src, dst, lo, mid, hi);
+        }
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != a)
+        memcpy(a, src, n * sizeof(int));
+
+    free(own);
 }
 
 /**
- * @brief Recursively sort an array in ascending order with Θ(nlogn) time complexity, where n = r-p+1 
+ * @brief Sort an array in ascending order with Θ(nlogn) time complexity, where n = r-p+1 
  * 
  * @param a array to be sorted
  * @param p first index of array to be sorted
@@ -59,12 +112,181 @@ void mergesort(int* a, int p, int r)
         return;
 
     if(p < r)
+        bottomup_mergesort(a + p, r - p + 1, NULL);
+}
+
+/**
+ * @brief Find where the k-th diagonal of the merge path of x and y crosses, 
+ *        i.e. how many of the first k merged elements come from x
+ * 
+ * @param x first ordered array
+ * @param nx size of x
+ * @param y second ordered array
+ * @param ny size of y
+ * @param k number of merged elements
+ * @return number of elements taken from x
+ */
+static
+int merge_path(const int* x, int nx, const int* y, int ny, int k)
+{
+    int lo = (k > ny) ? k - ny : 0;
+    int hi = (k < nx) ? k : nx;
+
+    while(lo < hi)
+    {
+        int i = lo + (hi - lo) / 2;
+
+        //ties are taken from x first, as in a scalar merge
+        if(x[i] <= y[k - i - 1])
+            lo = i + 1;
+        else
+            hi = i;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Shared state of a parallel mergesort pass
+ * 
+ */
+typedef struct ms_pass_s
+{
+    const int*  src;
+    int*        dst;
+    int         n;
+    int         w;          // width of the runs being merged
+    int         pieces;     // merge path splits per pair of runs
+
+}ms_pass_t;
+
+/**
+ * @brief Sort the chunks [lo,hi) of the array serially, each one in place
+ */
+static
+void sort_chunks(int lo, int hi, void* ctx)
+{
+    ms_pass_t* ps = ctx;
+
+    for(int c = lo; c < hi; c++)
     {
-        int q = (r + p)/2;      //Θ(k), k is constant 
-        mergesort(a,p,q);       //T(n/2)
-        mergesort(a, q+1,r);    //T(n/2)
-        merge(a,p,q,r);         //Θ(n)
-        
-        //T(n) = 2T(n/2) + Θ(n) + Θ(k)
+        int p = c * ps->w;
+        int r = (p + ps->w < ps->n) ? p + ps->w : ps->n;
+
+        bottomup_mergesort((int*)ps->src + p, r - p, ps->dst + p);
+    }
+}
+
+/**
+ * @brief Merge the pieces [lo,hi) of a pass. Piece t covers part t % pieces
+ *        of the merge path of pair t / pieces.
+ */
+static
+void merge_pieces(int lo, int hi, void* ctx)
+{
+    ms_pass_t* ps = ctx;
+
+    for(int t = lo; t < hi; t++)
+    {
+        int pair = t / ps->pieces;
+        int part = t % ps->pieces;
+        int p = pair * 2 * ps->w;
+        int q = (p + ps->w < ps->n) ? p + ps->w : ps->n;
+        int r = (q + ps->w < ps->n) ? q + ps->w : ps->n;
+        const int* x = ps->src + p;
+        const int* y = ps->src + q;
+        int nx = q - p;
+        int ny = r - q;
+
+        int k0 = (int)((long long)(nx + ny) * part / ps->pieces);
+        int k1 = (int)((long long)(nx + ny) * (part + 1) / ps->pieces);
+        int i0 = merge_path(x, nx, y, ny, k0);
+        int i1 = merge_path(x, nx, y, ny, k1);
+
+        sortnet_merge(x + i0, i1 - i0, y + (k0 - i0), (k1 - i1) - (k0 - i0), ps->dst + p + k0);
+    }
+}
+
+static
+void copy_blocks(int lo, int hi, void* ctx)
+{
+    ms_pass_t* ps = ctx;
+
+    memcpy(ps->dst + lo, ps->src + lo, (hi - lo) * sizeof(int));
+}
+
+/**
+ * @brief Sort an array in ascending order with mergesort on a pool of threads.
+ *        Chunks are sorted in parallel and every merge pass, including the last one, 
+ *        is split across threads along the merge path.
+ * 
+ * @param a array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ */
+void parallel_mergesort(int* a, int p, int r, int nthreads)
+{
+    pool_t* pool;
+    ms_pass_t ps;
+    int* buf;
+    int* tmp;
+    int n, chunks;
+
+    if(a == NULL || p >= r)
+        return;
+
+    n = r - p + 1;
+    a += p;
+
+    if(n <= 2 * PARALLEL_GRAIN || nthreads == 1)
+    {
+        bottomup_mergesort(a, n, NULL);
+        return;
+    }
+
+    buf = malloc(n * sizeof(int));
+    if(buf == NULL || (pool = pool_create(nthreads)) == NULL)
+    {
+        free(buf);
+        bottomup_mergesort(a, n, NULL);
+        return;
     }
-}
\ No newline at end of file
+
+    chunks = pool->nthreads;
+    if(chunks > n / PARALLEL_GRAIN)
+        chunks = n / PARALLEL_GRAIN;
+
+    ps.n = n;
+    ps.w = (n + chunks - 1) / chunks;
+    ps.src = a;
+    ps.dst = buf;
+    pool_parallel_for(pool, chunks, 1, sort_chunks, &ps);
+
+    for(; ps.w < n; ps.w *= 2)
+    {
+        int pairs = (n + 2 * ps.w - 1) / (2 * ps.w);
+
+        //split each pair so that every thread gets roughly one piece
+        ps.pieces = (pool->nthreads + pairs - 1) / pairs;
+        if(ps.pieces > 2 * ps.w / PARALLEL_GRAIN)
+            ps.pieces = 2 * ps.w / PARALLEL_GRAIN;
+        if(ps.pieces < 1)
+            ps.pieces = 1;
+
+        pool_parallel_for(pool, pairs * ps.pieces, 1, merge_pieces, &ps);
+
+        tmp = (int*)ps.src;
+        ps.src = ps.dst;
+        ps.dst = tmp;
+    }
+
+    if(ps.src != a)
+    {
+        ps.dst = a;
+        pool_parallel_for(pool, n, PARALLEL_GRAIN, copy_blocks, &ps);
+    }
+
+    pool_destroy(pool);
+    free(buf);
+}
@@ -0,0 +1,168 @@
+/**
+ * @file    monoqueue.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../inc/monoqueue.h"
+
+#define BUCKET_MIN_CAP  8
+
+static inline
+void bucket_push(kv_bucket_t* b, int k, int v)
+{
+    if(b->n == b->cap)
+    {
+        b->cap = b->cap ? 2 * b->cap : BUCKET_MIN_CAP;
+        b->items = realloc(b->items, b->cap * sizeof(key_value_t));
+    }
+
+    b->items[b->n].key = k;
+    b->items[b->n].value = v;
+    b->n++;
+}
+
+/**
+ * @brief Radix heap bucket of priority v: 0 if v equals the last extracted
+ *        priority, otherwise one more than the highest bit where they differ
+ */
+static inline
+int rheap_bucket(rheap_t* heap, unsigned v)
+{
+    unsigned x = v ^ heap->last;
+
+    return x ? 32 - __builtin_clz(x) : 0;
+}
+
+rheap_t* rheap_create(void)
+{
+    return calloc(1, sizeof(rheap_t));
+}
+
+void rheap_destroy(rheap_t* heap)
+{
+    if(heap == NULL)
+        return;
+
+    for(int i = 0; i < 33; i++)
+        free(heap->bucket[i].items);
+    free(heap);
+}
+
+bool rheap_insert(rheap_t* heap, int k, int v)
+{
+    //below the last extracted priority there is no bucket for v
+    if(v < 0 || (unsigned)v < heap->last)
+        return false;
+
+    bucket_push(&heap->bucket[rheap_bucket(heap, (unsigned)v)], k, v);
+    heap->ctr++;
+
+    return true;
+}
+
+int rheap_extract_min(rheap_t* heap, key_value_t* pair)
+{
+    kv_bucket_t* b;
+    int i;
+
+    if(heap->ctr == 0)
+        return 0;
+
+    //refill bucket 0 from the first non-empty bucket: its minimum becomes
+    //the new last, and every item in it moves to a lower bucket
+    if(heap->bucket[0].n == 0)
+    {
+        for(i = 1; heap->bucket[i].n == 0; i++)
+            ;
+
+        b = &heap->bucket[i];
+        unsigned m = (unsigned)b->items[0].value;
+        for(int j = 1; j < b->n; j++)
+        {
+            if((unsigned)b->items[j].value < m)
+                m = (unsigned)b->items[j].value;
+        }
+
+        heap->last = m;
+        for(int j = 0; j < b->n; j++)
+        {
+            key_value_t* it = &b->items[j];
+            bucket_push(&heap->bucket[rheap_bucket(heap, (unsigned)it->value)], it->key, it->value);
+        }
+        b->n = 0;
+    }
+
+    b = &heap->bucket[0];
+    *pair = b->items[--b->n];
+    heap->ctr--;
+
+    return 1;
+}
+
+
+bucketq_t* bucketq_create(int max_weight)
+{
+    bucketq_t* q = malloc(sizeof(bucketq_t));
+
+    q->nb = max_weight + 1;
+    q->bucket = calloc(q->nb, sizeof(kv_bucket_t));
+    q->cur = 0;
+    q->idx = 0;
+    q->ctr = 0;
+
+    return q;
+}
+
+void bucketq_destroy(bucketq_t* q)
+{
+    if(q == NULL)
+        return;
+
+    for(int i = 0; i < q->nb; i++)
+        free(q->bucket[i].items);
+    free(q->bucket);
+    free(q);
+}
+
+int bucketq_insert(bucketq_t* q, int k, int v)
+{
+    int i;
+
+    if(v < q->cur || v - q->cur >= q->nb)
+        return 0;
+
+    i = q->idx + (v - q->cur);
+    if(i >= q->nb)
+        i -= q->nb;
+
+    bucket_push(&q->bucket[i], k, v);
+    q->ctr++;
+
+    return 1;
+}
+
+int bucketq_extract_min(bucketq_t* q, key_value_t* pair)
+{
+    kv_bucket_t* b;
+
+    if(q->ctr == 0)
+        return 0;
+
+    while(q->bucket[q->idx].n == 0)
+    {
+        q->cur++;
+        if(++q->idx == q->nb)
+            q->idx = 0;
+    }
+
+    b = &q->bucket[q->idx];
+    *pair = b->items[--b->n];
+    q->ctr--;
+
+    return 1;
+}
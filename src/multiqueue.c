@@ -0,0 +1,176 @@
+/**
+ * @file    multiqueue.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../inc/multiqueue.h"
+#include "../inc/threadpool.h"
+
+// initial capacity of each heap, they grow as needed
+#define MQ_HEAP_SIZE    64
+
+static atomic_uint mq_seeds = 1;
+static _Thread_local uint32_t mq_seed;
+
+/**
+ * @brief xorshift32 random generator with a state per thread
+ */
+static inline
+uint32_t mq_rand(void)
+{
+    uint32_t x = mq_seed;
+
+    if(x == 0)
+        x = atomic_fetch_add(&mq_seeds, 1) * 0x9E3779B9u | 1;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return mq_seed = x;
+}
+
+/**
+ * @brief Random heap of the queue
+ */
+static inline
+mq_heap_t* mq_pick(multiqueue_t* mq)
+{
+    return &mq->q[((uint64_t)mq_rand() * mq->nq) >> 32];
+}
+
+static inline
+bool mq_trylock(mq_heap_t* h)
+{
+    return atomic_load_explicit(&h->lock, memory_order_relaxed) == 0 &&
+           atomic_exchange_explicit(&h->lock, 1, memory_order_acquire) == 0;
+}
+
+static inline
+void mq_lock(mq_heap_t* h)
+{
+    while(!mq_trylock(h))
+        ;
+}
+
+/**
+ * @brief Publish the root and size of a locked heap, then release it
+ */
+static inline
+void mq_unlock(mq_heap_t* h)
+{
+    heap_t* heap = h->heap;
+
+    atomic_store_explicit(&h->ctr, heap->ctr, memory_order_relaxed);
+    atomic_store_explicit(&h->top, heap->ctr ? heap->pair[0].value : INT_MAX, memory_order_relaxed);
+    atomic_store_explicit(&h->lock, 0, memory_order_release);
+}
+
+multiqueue_t* multiqueue_create(int nthreads, int c)
+{
+    multiqueue_t* mq = malloc(sizeof(multiqueue_t));
+
+    if(nthreads <= 0)
+        nthreads = pool_cpus();
+    if(c <= 0)
+        c = MULTIQUEUE_C;
+
+    mq->nq = c * nthreads;
+    mq->q = aligned_alloc(_Alignof(mq_heap_t), mq->nq * sizeof(mq_heap_t));
+
+    for(int i = 0; i < mq->nq; i++)
+    {
+        atomic_init(&mq->q[i].lock, 0);
+        atomic_init(&mq->q[i].top, INT_MAX);
+        atomic_init(&mq->q[i].ctr, 0);
+        mq->q[i].heap = min_heap(MQ_HEAP_SIZE);
+    }
+
+    return mq;
+}
+
+void multiqueue_destroy(multiqueue_t* mq)
+{
+    if(mq == NULL)
+        return;
+
+    for(int i = 0; i < mq->nq; i++)
+        destroy_heap(mq->q[i].heap);
+
+    free(mq->q);
+    free(mq);
+}
+
+void multiqueue_insert(multiqueue_t* mq, int k, int v)
+{
+    mq_heap_t* h;
+
+    //a busy heap is skipped for another random one instead of waited on
+    do
+    {
+        h = mq_pick(mq);
+    }
+    while(!mq_trylock(h));
+
+    min_insert(h->heap, k, v);
+    mq_unlock(h);
+}
+
+int multiqueue_extract_min(multiqueue_t* mq, key_value_t* pair)
+{
+    mq_heap_t* h;
+
+    for(int t = 0; t < mq->nq; t++)
+    {
+        mq_heap_t* a = mq_pick(mq);
+        mq_heap_t* b = mq_pick(mq);
+        int na = atomic_load_explicit(&a->ctr, memory_order_relaxed);
+        int nb = atomic_load_explicit(&b->ctr, memory_order_relaxed);
+
+        if(na == 0 && nb == 0)
+            continue;
+
+        //the smaller of the two roots, as last published
+        if(nb == 0 || (na != 0 && atomic_load_explicit(&a->top, memory_order_relaxed) <=
+                                  atomic_load_explicit(&b->top, memory_order_relaxed)))
+            h = a;
+        else
+            h = b;
+
+        if(!mq_trylock(h))
+            continue;
+
+        if(extract_min(h->heap, pair))
+        {
+            mq_unlock(h);
+            return 1;
+        }
+
+        mq_unlock(h);
+    }
+
+    //random probes keep missing: the queue is close to empty, so look at every heap
+    for(int i = 0; i < mq->nq; i++)
+    {
+        h = &mq->q[i];
+
+        if(atomic_load_explicit(&h->ctr, memory_order_relaxed) == 0)
+            continue;
+
+        mq_lock(h);
+        if(extract_min(h->heap, pair))
+        {
+            mq_unlock(h);
+            return 1;
+        }
+        mq_unlock(h);
+    }
+
+    return 0;
+}
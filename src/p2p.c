@@ -0,0 +1,264 @@
+/**
+ * @file    p2p.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "../inc/p2p.h"
+
+#define FORWARD     0
+#define BACKWARD    1
+
+p2p_t* p2p_create(graph_t* g)
+{
+    p2p_t* p = malloc(sizeof(p2p_t));
+
+    p->g = g;
+    p->rev = g->dir ? NULL : g;
+    p->query = 0;
+    p->touched = 0;
+    p->est = (int*)malloc(g->nv * sizeof(int));
+
+    for(int s = FORWARD; s <= BACKWARD; s++)
+    {
+        p->seen[s] = (unsigned*)calloc(g->nv, sizeof(unsigned));
+        p->cost[s] = (int*)malloc(g->nv * sizeof(int));
+        p->prev[s] = (int*)malloc(g->nv * sizeof(int));
+        p->q[s] = min_heap(64);
+    }
+
+    return p;
+}
+
+void p2p_destroy(p2p_t* p)
+{
+    if(p == NULL)
+        return;
+
+    if(p->rev != NULL && p->rev != p->g)
+        destroy_graph(p->rev);
+
+    for(int s = FORWARD; s <= BACKWARD; s++)
+    {
+        free(p->seen[s]);
+        free(p->cost[s]);
+        free(p->prev[s]);
+        destroy_heap(p->q[s]);
+    }
+
+    free(p->est);
+    free(p);
+}
+
+/**
+ * @brief Start a new query, invalidating every cost of the previous one
+ */
+static
+void p2p_begin(p2p_t* p)
+{
+    //stamps are about to repeat, clear them once every 2^32 queries
+    if(++p->query == 0)
+    {
+        memset(p->seen[FORWARD], 0, p->g->nv * sizeof(unsigned));
+        memset(p->seen[BACKWARD], 0, p->g->nv * sizeof(unsigned));
+        p->query = 1;
+    }
+
+    p->q[FORWARD]->ctr = 0;
+    p->q[BACKWARD]->ctr = 0;
+    p->touched = 0;
+}
+
+static inline
+bool p2p_seen(p2p_t* p, int s, int v)
+{
+    return p->seen[s][v] == p->query;
+}
+
+/**
+ * @brief Lower the cost of v in search s to c through u
+ *
+ * @return true if c is better than what v had
+ */
+static inline
+bool p2p_relax(p2p_t* p, int s, int u, int v, int c)
+{
+    if(!p2p_seen(p, s, v))
+    {
+        p->seen[s][v] = p->query;
+        p->touched++;
+    }
+    else if(c >= p->cost[s][v])
+        return false;
+
+    p->cost[s][v] = c;
+    p->prev[s][v] = u;
+
+    return true;
+}
+
+/**
+ * @brief Copy the path ending at meet out of the forward parents, and the one
+ *        starting at meet out of the backward parents, if any
+ */
+static
+void p2p_path(p2p_t* p, int meet, bool backward, path_t* path)
+{
+    int nf = 0, nb = 0, i;
+
+    if(path == NULL)
+        return;
+
+    for(int x = meet; x != -1; x = p->prev[FORWARD][x])
+        nf++;
+    for(int x = backward ? p->prev[BACKWARD][meet] : -1; x != -1; x = p->prev[BACKWARD][x])
+        nb++;
+
+    path->v = (int*)malloc((nf + nb) * sizeof(int));
+    path->n = nf + nb;
+
+    //src .. meet, walked back from meet
+    i = nf;
+    for(int x = meet; x != -1; x = p->prev[FORWARD][x])
+        path->v[--i] = x;
+
+    //then on to dst
+    i = nf;
+    for(int x = backward ? p->prev[BACKWARD][meet] : -1; x != -1; x = p->prev[BACKWARD][x])
+        path->v[i++] = x;
+}
+
+static
+int p2p_unreachable(path_t* path)
+{
+    if(path)
+    {
+        path->v = NULL;
+        path->n = 0;
+    }
+
+    return INT_MAX;
+}
+
+int p2p_dijkstra(p2p_t* p, int src, int dst, path_t* path)
+{
+    return p2p_astar(p, src, dst, NULL, NULL, path);
+}
+
+int p2p_astar(p2p_t* p, int src, int dst, heuristic_fn h, void* ctx, path_t* path)
+{
+    heap_t* q = p->q[FORWARD];
+    key_value_t item;
+
+    p2p_begin(p);
+    p2p_relax(p, FORWARD, -1, src, 0);
+    p->est[src] = h ? h(src, dst, ctx) : 0;
+    min_insert(q, src, p->est[src]);
+
+    while(extract_min(q, &item))
+    {
+        int u = item.key;
+
+        //stale, u was reached again at a lower cost
+        if(item.value > p->cost[FORWARD][u] + p->est[u])
+            continue;
+
+        if(u == dst)
+        {
+            p2p_path(p, dst, false, path);
+            return p->cost[FORWARD][dst];
+        }
+
+        for(struct node* tmp = p->g->adj[u]; tmp; tmp = tmp->next)
+        {
+            int v = tmp->v;
+            bool first = !p2p_seen(p, FORWARD, v);
+
+            if(p2p_relax(p, FORWARD, u, v, p->cost[FORWARD][u] + tmp->w))
+            {
+                if(first)
+                    p->est[v] = h ? h(v, dst, ctx) : 0;
+
+                min_insert(q, v, p->cost[FORWARD][v] + p->est[v]);
+            }
+        }
+    }
+
+    return p2p_unreachable(path);
+}
+
+int p2p_bidirectional(p2p_t* p, int src, int dst, path_t* path)
+{
+    long long best = LLONG_MAX;
+    int meet = -1;
+    key_value_t item;
+
+    //only the backward search needs the transpose, built on the first query that runs it
+    if(p->rev == NULL)
+        p->rev = transpose_graph(p->g);
+
+    p2p_begin(p);
+    p2p_relax(p, FORWARD, -1, src, 0);
+    p2p_relax(p, BACKWARD, -1, dst, 0);
+    min_insert(p->q[FORWARD], src, 0);
+    min_insert(p->q[BACKWARD], dst, 0);
+
+    if(src == dst)
+    {
+        meet = src;
+        best = 0;
+    }
+
+    //an empty queue means its search is complete, and every meeting point was seen
+    while(p->q[FORWARD]->ctr && p->q[BACKWARD]->ctr)
+    {
+        int s = p->q[FORWARD]->ctr <= p->q[BACKWARD]->ctr ? FORWARD : BACKWARD;
+        graph_t* g = s == FORWARD ? p->g : p->rev;
+        int u;
+
+        //no path through an unsettled vertex can beat best
+        if((long long)p->q[FORWARD]->pair[0].value + p->q[BACKWARD]->pair[0].value >= best)
+            break;
+
+        extract_min(p->q[s], &item);
+        u = item.key;
+
+        if(item.value > p->cost[s][u])
+            continue;
+
+        for(struct node* tmp = g->adj[u]; tmp; tmp = tmp->next)
+        {
+            int v = tmp->v;
+
+            if(p2p_relax(p, s, u, v, p->cost[s][u] + tmp->w))
+                min_insert(p->q[s], v, p->cost[s][v]);
+
+            if(p2p_seen(p, !s, v) && (long long)p->cost[s][v] + p->cost[!s][v] < best)
+            {
+                best = (long long)p->cost[s][v] + p->cost[!s][v];
+                meet = v;
+            }
+        }
+    }
+
+    if(meet == -1)
+        return p2p_unreachable(path);
+
+    p2p_path(p, meet, true, path);
+    return (int)best;
+}
+
+int p2p_euclidean(int v, int dst, void* ctx)
+{
+    const p2p_coords_t* c = ctx;
+    double dx = c->x[v] - c->x[dst];
+    double dy = c->y[v] - c->y[dst];
+
+    return (int)floor(c->scale * sqrt(dx * dx + dy * dy));
+}
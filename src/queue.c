@@ -0,0 +1,335 @@
+/**
+ * @file    queue.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../inc/queue.h"
+
+/**
+ * @brief Smallest power of two not below n
+ */
+static
+size_t pow2_ceil(size_t n)
+{
+    size_t p = 1;
+
+    while(p < n)
+        p <<= 1;
+
+    return p;
+}
+
+bool queue(queue_t* q, int size)
+{
+    if(q == NULL)
+        return false;
+
+    q->ctr = 0;
+    q->size = (int)pow2_ceil(size > 0 ? size : 1);
+    q->head = 0;
+    q->tail = 0;
+
+    q->ptr = (int*)malloc(q->size * sizeof(int));
+
+    return q->ptr != NULL;
+}
+
+void queue_delete(queue_t* q)
+{
+    if(q == NULL)
+        return;
+
+    free(q->ptr);
+    q->ptr = NULL;
+}
+
+/**
+ * @brief Double the capacity of a full queue, unwrapping its items to the start
+ */
+static
+bool queue_grow(queue_t* q)
+{
+    int* ptr = (int*)malloc(2 * q->size * sizeof(int));
+
+    if(ptr == NULL)
+        return false;
+
+    memcpy(ptr, q->ptr + q->head, (q->size - q->head) * sizeof(int));
+    memcpy(ptr + q->size - q->head, q->ptr, q->head * sizeof(int));
+
+    free(q->ptr);
+    q->ptr = ptr;
+    q->head = 0;
+    q->tail = q->size;
+    q->size *= 2;
+
+    return true;
+}
+
+bool enqueue(queue_t* q, int in)
+{
+    if(q == NULL)
+        return false;
+
+    if(q->ctr == q->size && !queue_grow(q))
+        return false;
+
+    q->ptr[q->tail] = in;
+    q->tail = (q->tail + 1) & (q->size - 1);
+    q->ctr++;
+
+    return true;
+}
+
+bool dequeue(queue_t* q, int* out)
+{
+    if(q == NULL || out == NULL || !q->ctr)
+        return false;
+
+    *out = q->ptr[q->head];
+    q->head = (q->head + 1) & (q->size - 1);
+    q->ctr--;
+
+    return true;
+}
+
+
+spsc_t* spsc_create(size_t size)
+{
+    spsc_t* q = aligned_alloc(_Alignof(spsc_t), sizeof(spsc_t));
+
+    size = pow2_ceil(size);
+    q->ptr = malloc(size * sizeof(int));
+    q->mask = size - 1;
+    q->head_cache = 0;
+    q->tail_cache = 0;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+
+    return q;
+}
+
+void spsc_destroy(spsc_t* q)
+{
+    if(q == NULL)
+        return;
+
+    free(q->ptr);
+    free(q);
+}
+
+/**
+ * @brief Number of free slots seen by the producer, reloading head only when
+ *        the cached copy shows fewer than n
+ */
+static inline
+size_t spsc_free(spsc_t* q, size_t tail, size_t n)
+{
+    size_t cap = q->mask + 1;
+
+    if(cap - (tail - q->head_cache) < n)
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    return cap - (tail - q->head_cache);
+}
+
+/**
+ * @brief Number of items seen by the consumer, reloading tail only when
+ *        the cached copy shows fewer than n
+ */
+static inline
+size_t spsc_used(spsc_t* q, size_t head, size_t n)
+{
+    if(q->tail_cache - head < n)
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    return q->tail_cache - head;
+}
+
+bool spsc_enqueue(spsc_t* q, int in)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if(spsc_free(q, tail, 1) == 0)
+        return false;
+
+    q->ptr[tail & q->mask] = in;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool spsc_dequeue(spsc_t* q, int* out)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if(spsc_used(q, head, 1) == 0)
+        return false;
+
+    *out = q->ptr[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+size_t spsc_enqueue_batch(spsc_t* q, const int* in, size_t n)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t room = spsc_free(q, tail, n);
+
+    if(n > room)
+        n = room;
+
+    for(size_t i = 0; i < n; i++)
+        q->ptr[(tail + i) & q->mask] = in[i];
+
+    atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+
+    return n;
+}
+
+size_t spsc_dequeue_batch(spsc_t* q, int* out, size_t n)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t avail = spsc_used(q, head, n);
+
+    if(n > avail)
+        n = avail;
+
+    for(size_t i = 0; i < n; i++)
+        out[i] = q->ptr[(head + i) & q->mask];
+
+    atomic_store_explicit(&q->head, head + n, memory_order_release);
+
+    return n;
+}
+
+
+mpmc_t* mpmc_create(size_t size)
+{
+    mpmc_t* q = aligned_alloc(_Alignof(mpmc_t), sizeof(mpmc_t));
+
+    size = pow2_ceil(size < 2 ? 2 : size);
+    q->cells = malloc(size * sizeof(mpmc_cell_t));
+    q->mask = size - 1;
+
+    for(size_t i = 0; i < size; i++)
+        atomic_init(&q->cells[i].seq, i);
+
+    atomic_init(&q->enqueue_pos, 0);
+    atomic_init(&q->dequeue_pos, 0);
+
+    return q;
+}
+
+void mpmc_destroy(mpmc_t* q)
+{
+    if(q == NULL)
+        return;
+
+    free(q->cells);
+    free(q);
+}
+
+/**
+ * @brief Claim up to n consecutive positions from *pos_var. Cell pos+i is ready
+ *        when its sequence number is pos+i+ready; only the ready prefix is claimed.
+ *        Nobody else can take a claimed cell, because positions are only handed
+ *        out by the CAS
+ *
+ * @param q pointer to queue
+ * @param pos_var enqueue_pos or dequeue_pos
+ * @param ready 0 for producers, 1 for consumers
+ * @param n most positions wanted
+ * @param first returns the first claimed position
+ * @return number of positions claimed, 0 if the queue is full (producers) or empty (consumers)
+ */
+static inline
+size_t mpmc_claim(mpmc_t* q, atomic_size_t* pos_var, size_t ready, size_t n, size_t* first)
+{
+    size_t pos = atomic_load_explicit(pos_var, memory_order_relaxed);
+
+    if(n == 0)
+        return 0;
+
+    for(;;)
+    {
+        intptr_t dif = 0;
+        size_t k = 0;
+
+        while(k < n)
+        {
+            mpmc_cell_t* cell = &q->cells[(pos + k) & q->mask];
+
+            dif = (intptr_t)atomic_load_explicit(&cell->seq, memory_order_acquire) - (intptr_t)(pos + k + ready);
+            if(dif != 0)
+                break;
+
+            k++;
+        }
+
+        if(k == 0)
+        {
+            if(dif < 0)
+                return 0;
+
+            //a later sequence number means another thread took pos first
+            pos = atomic_load_explicit(pos_var, memory_order_relaxed);
+            continue;
+        }
+
+        if(atomic_compare_exchange_weak_explicit(pos_var, &pos, pos + k, memory_order_relaxed, memory_order_relaxed))
+        {
+            *first = pos;
+            return k;
+        }
+    }
+}
+
+bool mpmc_enqueue(mpmc_t* q, int in)
+{
+    return mpmc_enqueue_batch(q, &in, 1) == 1;
+}
+
+bool mpmc_dequeue(mpmc_t* q, int* out)
+{
+    return mpmc_dequeue_batch(q, out, 1) == 1;
+}
+
+size_t mpmc_enqueue_batch(mpmc_t* q, const int* in, size_t n)
+{
+    size_t pos;
+    size_t k = mpmc_claim(q, &q->enqueue_pos, 0, n, &pos);
+
+    for(size_t i = 0; i < k; i++)
+    {
+        mpmc_cell_t* cell = &q->cells[(pos + i) & q->mask];
+
+        cell->data = in[i];
+        atomic_store_explicit(&cell->seq, pos + i + 1, memory_order_release);
+    }
+
+    return k;
+}
+
+size_t mpmc_dequeue_batch(mpmc_t* q, int* out, size_t n)
+{
+    size_t pos;
+    size_t k = mpmc_claim(q, &q->dequeue_pos, 1, n, &pos);
+
+    for(size_t i = 0; i < k; i++)
+    {
+        mpmc_cell_t* cell = &q->cells[(pos + i) & q->mask];
+
+        out[i] = cell->data;
+        atomic_store_explicit(&cell->seq, pos + i + q->mask + 1, memory_order_release);
+    }
+
+    return k;
+}
@@ -7,6 +7,21 @@
  */
 
 #include <stdlib.h>
+#include "../inc/sort.h"
+#include "../inc/threadpool.h"
+#include "../inc/sortnet.h"
+
+// sub-arrays up to this size are finished by a sorting network
+#define SMALL_CUTOFF        32
+
+// sub-arrays bigger than this use the ninther instead of median-of-three
+#define NINTHER_CUTOFF      128
+
+// elements classified per block by block_partition(), at most 256
+#define PARTITION_BLOCK_SIZE 128
+
+// sub-arrays up to this size are sorted serially by a single task
+#define PARALLEL_GRAIN      16384
 
 /**
  * @brief Swaps 2 elements of an array
@@ -15,6 +30,7 @@
  * @param i index of first element
  * @param j index of second element
  */
+static inline
 void swap(int* a, int i, int j)
 {
     register int aux = a[i];
@@ -73,16 +89,521 @@ int rand_partition(int* a, int p, int r)
 /**
  * @brief Recursively sort an array in ascending order with 
  *        average time complexity Θ(nlogn) and worst case of Θ(n²)
+ *        using a randomly chosen pivot on each partition
  * 
  * @param p first index of array to be sorted
  * @param r last index of array to be sorted
  */
-void quicksort(int* a, int p, int r)
+void randomized_quicksort(int* a, int p, int r)
 {
     if(p < r)
     {
         int q = rand_partition(a,p,r);
-        quicksort(a,p, q-1);
-        quicksort(a,q+1,r);
+        randomized_quicksort(a,p, q-1);
+        randomized_quicksort(a,q+1,r);
+    }
+}
+
+/**
+ * @brief Index of the median among a[i], a[j] and a[k]
+ */
+static inline
+int median3(int* a, int i, int j, int k)
+{
+    if(a[i] < a[j])
+    {
+        if(a[j] < a[k])
+            return j;
+
+        return (a[i] < a[k]) ? k : i;
+    }
+
+    if(a[i] < a[k])
+        return i;
+
+    return (a[j] < a[k]) ? k : j;
+}
+
+/**
+ * @brief Choose a pivot for sub-array a[p,...,r] using median-of-three on 
+ *        small ranges and Tukey's ninther (median of three medians) on large ones
+ * 
+ * @param a pointer to array
+ * @param p first index of sub-array
+ * @param r last index of sub-array
+ * @return index of the chosen pivot
+ */
+static
+int choose_pivot(int* a, int p, int r)
+{
+    int n = r - p + 1;
+    int m = p + n/2;
+
+    if(n > NINTHER_CUTOFF)
+    {
+        int s = n/8;
+        int lo = median3(a, p, p + s, p + 2*s);
+        int mi = median3(a, m - s, m, m + s);
+        int hi = median3(a, r - 2*s, r - s, r);
+
+        return median3(a, lo, mi, hi);
+    }
+
+    return median3(a, p, m, r);
+}
+
+/**
+ * @brief Three-way (fat) partition of a[p,...,r] around a pivot value, 
+ *        so that runs of keys equal to the pivot are never visited again.
+ *        After the call a[p,...,lt-1] < pivot, a[lt,...,gt] == pivot 
+ *        and a[gt+1,...,r] > pivot
+ * 
+ * @param a Pointer to the array to be partitioned
+ * @param p first index of array
+ * @param r last index of array
+ * @param pivot pivot value
+ * @param lt returns the first index of the block equal to the pivot
+ * @param gt returns the last index of the block equal to the pivot
+ */
+static
+void partition3(int* a, int p, int r, int pivot, int* lt, int* gt)
+{
+    int i = p;
+    int l = p;
+    int g = r;
+
+    while(i <= g)
+    {
+        if(a[i] < pivot)
+            swap(a, l++, i++);
+        else if(a[i] > pivot)
+            swap(a, i, g--);
+        else
+            i++;
+    }
+
+    *lt = l;
+    *gt = g;
+}
+
+/**
+ * @brief Branchless block partition (BlockQuicksort) of a[p,...,r] around the pivot in a[p].
+ *        Elements are compared a block at a time and the offsets of misplaced ones are
+ *        written to small buffers without branching on the comparison, then swapped
+ *        in bulk. Equal keys go to either side, so duplicates still split evenly.
+ * 
+ * @param a Pointer to the array to be partitioned
+ * @param p first index of array, holding the pivot
+ * @param r last index of array
+ * @return the pivot new position
+ */
+static
+int block_partition(int* a, int p, int r)
+{
+    unsigned char offl[PARTITION_BLOCK_SIZE];
+    unsigned char offr[PARTITION_BLOCK_SIZE];
+    int startl = 0, numl = 0;
+    int startr = 0, numr = 0;
+    int pivot = a[p];
+    int l = p + 1;          // first unclassified element on the left
+    int h = r;              // last unclassified element on the right
+
+    while(h - l + 1 >= 2 * PARTITION_BLOCK_SIZE)
+    {
+        if(numl == 0)
+        {
+            startl = 0;
+            for(int i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offl[numl] = i;
+                numl += (a[l + i] >= pivot);
+            }
+        }
+
+        if(numr == 0)
+        {
+            startr = 0;
+            for(int i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offr[numr] = i;
+                numr += (a[h - i] <= pivot);
+            }
+        }
+
+        int num = (numl < numr) ? numl : numr;
+        for(int k = 0; k < num; k++)
+            swap(a, l + offl[startl + k], h - offr[startr + k]);
+
+        numl -= num;
+        numr -= num;
+        startl += num;
+        startr += num;
+
+        if(numl == 0)
+            l += PARTITION_BLOCK_SIZE;
+
+        if(numr == 0)
+            h -= PARTITION_BLOCK_SIZE;
+    }
+
+    //finish the last few blocks with a plain Hoare partition, 
+    //a[p+1,...,l-1] <= pivot and a[h+1,...,r] >= pivot already hold
+    for(;;)
+    {
+        while(l <= h && a[l] < pivot)
+            l++;
+
+        while(l <= h && a[h] > pivot)
+            h--;
+
+        if(l >= h)
+        {
+            if(l == h)
+                l++;
+            break;
+        }
+
+        swap(a, l++, h--);
+    }
+
+    swap(a, p, l - 1);
+
+    return l - 1;
+}
+
+/**
+ * @brief Number of partitioning levels allowed before introsort falls back 
+ *        to heapsort, 2*floor(log2(n))
+ * 
+ * @param n size of the array
+ */
+static
+int depth_limit(int n)
+{
+    int depth = 0;
+
+    for(; n > 1; n >>= 1)
+        depth += 2;
+
+    return depth;
+}
+
+/**
+ * @brief Introsort main loop. Recurses only on the smaller side of each 
+ *        partition, so the stack depth is bounded by O(logn), and falls back to 
+ *        heapsort once the depth budget is exhausted
+ * 
+ * @param a pointer to array
+ * @param p first index of sub-array
+ * @param r last index of sub-array
+ * @param depth number of partitioning levels left before falling back to heapsort
+ * @param scheme partition scheme, PARTITION_THREE_WAY or PARTITION_BLOCK
+ */
+static
+void introsort_loop(int* a, int p, int r, int depth, int scheme)
+{
+    int lt, gt;
+
+    while(r - p + 1 > SMALL_CUTOFF)
+    {
+        if(depth == 0)
+        {
+            heapsort(a + p, r - p + 1);
+            return;
+        }
+        depth--;
+
+        if(scheme == PARTITION_BLOCK)
+        {
+            swap(a, p, choose_pivot(a, p, r));
+            lt = gt = block_partition(a, p, r);
+        }
+        else
+        {
+            partition3(a, p, r, a[choose_pivot(a, p, r)], &lt, &gt);
+        }
+
+        if(lt - p < r - gt)
+        {
+            introsort_loop(a, p, lt-1, depth, scheme);
+            p = gt + 1;
+        }
+        else
+        {
+            introsort_loop(a, gt+1, r, depth, scheme);
+            r = lt - 1;
+        }
+    }
+
+    sortnet_sort(a + p, r - p + 1);
+}
+
+/**
+ * @brief Sort an array in ascending order with worst case time complexity Θ(nlogn)
+ *        using introsort: median-of-three/ninther pivots, three-way partitioning, 
+ *        sorting networks for small ranges and heapsort when recursion gets too deep
+ * 
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ */
+void quicksort(int* a, int p, int r)
+{
+    quicksort_with(a, p, r, PARTITION_THREE_WAY);
+}
+
+/**
+ * @brief Sort an array in ascending order with introsort using the given partition scheme
+ * 
+ * @param a pointer to array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param scheme PARTITION_THREE_WAY (best with many duplicate keys) or 
+ *               PARTITION_BLOCK (branchless, best with distinct keys)
+ */
+void quicksort_with(int* a, int p, int r, int scheme)
+{
+    if(a == NULL || p >= r)
+        return;
+
+    introsort_loop(a, p, r, depth_limit(r - p + 1), scheme);
+}
+
+/**
+ * @brief Sub-array to be sorted by a parallel quicksort task
+ * 
+ */
+typedef struct qs_task_s
+{
+    pool_t*     pool;
+    group_t*    group;
+    int*        a;
+    int         p;
+    int         r;
+    int         depth;
+
+}qs_task_t;
+
+/**
+ * @brief Parallel introsort task. Partitions its sub-array while it is bigger than 
+ *        the grain size, handing the smaller side of each partition to the pool, 
+ *        and sorts what is left serially
+ * 
+ * @param arg pointer to a qs_task_t, released by the task
+ */
+static
+void parallel_introsort(void* arg)
+{
+    qs_task_t* t = arg;
+    int* a = t->a;
+    int p = t->p;
+    int r = t->r;
+    int depth = t->depth;
+    int lt, gt;
+
+    while(r - p + 1 > PARALLEL_GRAIN && depth > 0)
+    {
+        qs_task_t* sub = malloc(sizeof(qs_task_t));
+
+        //no memory for another task, sort the rest on this thread
+        if(sub == NULL)
+            break;
+
+        depth--;
+
+        partition3(a, p, r, a[choose_pivot(a, p, r)], &lt, &gt);
+
+        *sub = *t;
+        sub->depth = depth;
+
+        if(lt - p < r - gt)
+        {
+            sub->p = p;
+            sub->r = lt - 1;
+            p = gt + 1;
+        }
+        else
+        {
+            sub->p = gt + 1;
+            sub->r = r;
+            r = lt - 1;
+        }
+
+        pool_submit(t->pool, t->group, parallel_introsort, sub);
+    }
+
+    introsort_loop(a, p, r, depth, PARTITION_THREE_WAY);
+    free(t);
+}
+
+/**
+ * @brief Sort an array in ascending order with introsort, running the recursion 
+ *        on a pool of threads above a grain size
+ * 
+ * @param a pointer to array to be sorted
+ * @param p first index of array to be sorted
+ * @param r last index of array to be sorted
+ * @param nthreads number of threads, or <= 0 to use all online CPUs
+ */
+void parallel_quicksort(int* a, int p, int r, int nthreads)
+{
+    pool_t* pool;
+    group_t group = {0};
+
+    if(a == NULL || p >= r)
+        return;
+
+    if(r - p + 1 <= PARALLEL_GRAIN || nthreads == 1 || (pool = pool_create(nthreads)) == NULL)
+    {
+        quicksort(a, p, r);
+        return;
     }
-}
\ No newline at end of file
+
+    qs_task_t* t = malloc(sizeof(qs_task_t));
+    if(t == NULL)
+    {
+        pool_destroy(pool);
+        quicksort(a, p, r);
+        return;
+    }
+
+    t->pool = pool;
+    t->group = &group;
+    t->a = a;
+    t->p = p;
+    t->r = r;
+    t->depth = depth_limit(r - p + 1);
+
+    pool_submit(pool, &group, parallel_introsort, t);
+    pool_wait(pool, &group);
+
+    pool_destroy(pool);
+}
+
+/**
+ * @brief Deterministic selection: rearrange a[p,...,r] so that a[k] is the element 
+ *        that would be there if the range were sorted, in worst case Θ(n)
+ * 
+ * @param a pointer to array
+ * @param p first index of sub-array
+ * @param r last index of sub-array
+ * @param k index to select, p <= k <= r
+ */
+static
+void mom_select(int* a, int p, int r, int k);
+
+/**
+ * @brief Median of medians of groups of five, a pivot guaranteed to leave 
+ *        at least 30% of a[p,...,r] on each side
+ * 
+ * @param a pointer to array
+ * @param p first index of sub-array
+ * @param r last index of sub-array
+ * @return the pivot value
+ */
+static
+int median_of_medians(int* a, int p, int r)
+{
+    int n = r - p + 1;
+    int m = 0;
+
+    if(n <= 5)
+    {
+        sortnet_sort(a + p, n);
+        return a[p + n/2];
+    }
+
+    //move the median of each group to the front of the range
+    for(int g = p; g <= r; g += 5)
+    {
+        int len = (g + 5 <= r + 1) ? 5 : r + 1 - g;
+
+        sortnet_sort(a + g, len);
+        swap(a, p + m, g + len/2);
+        m++;
+    }
+
+    mom_select(a, p, p + m - 1, p + m/2);
+
+    return a[p + m/2];
+}
+
+static
+void mom_select(int* a, int p, int r, int k)
+{
+    int lt, gt;
+
+    while(p < r)
+    {
+        partition3(a, p, r, median_of_medians(a, p, r), &lt, &gt);
+
+        if(k < lt)
+            r = lt - 1;
+        else if(k > gt)
+            p = gt + 1;
+        else
+            return;
+    }
+}
+
+/**
+ * @brief Rearrange an array so that a[k] is the element that would be there if the 
+ *        array were sorted, with a[0,...,k-1] <= a[k] <= a[k+1,...,n-1].
+ *        Uses introselect: random pivots with Θ(n) average time, falling back to 
+ *        median of medians for a Θ(n) worst case once too many partitions were needed
+ * 
+ * @param a pointer to array
+ * @param n size of the array
+ * @param k index to select, 0 <= k < n
+ */
+void select_nth(int* a, int n, int k)
+{
+    int p = 0;
+    int r = n - 1;
+    int budget;
+
+    if(a == NULL || k < 0 || k >= n)
+        return;
+
+    budget = depth_limit(n);
+    while(r - p + 1 > SMALL_CUTOFF)
+    {
+        if(budget-- == 0)
+        {
+            mom_select(a, p, r, k);
+            return;
+        }
+
+        int q = rand_partition(a, p, r);
+
+        if(k < q)
+            r = q - 1;
+        else if(k > q)
+            p = q + 1;
+        else
+            return;
+    }
+
+    sortnet_sort(a + p, r - p + 1);
+}
+
+/**
+ * @brief Rearrange an array so that a[0,...,k-1] holds its k smallest elements 
+ *        in ascending order, in Θ(n + klogk) time. The order of the remaining 
+ *        elements is unspecified
+ * 
+ * @param a pointer to array
+ * @param n size of the array
+ * @param k number of elements to sort
+ */
+void partial_sort(int* a, int n, int k)
+{
+    if(a == NULL || k <= 0)
+        return;
+
+    if(k < n)
+        select_nth(a, n, k);
+    else
+        k = n;
+
+    quicksort(a, 0, k - 1);
+}
@@ -0,0 +1,357 @@
+/**
+ * @file    radixsort.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../inc/sort.h"
+
+#define RADIX_BITS      11
+#define RADIX_BUCKETS   (1 << RADIX_BITS)
+#define RADIX_MASK      (RADIX_BUCKETS - 1)
+#define RADIX_PASSES    3           // ceil(32 / RADIX_BITS)
+
+// runs sorted by insertion before the in-place merge passes of the fallback
+#define KV_RUN          16
+
+/**
+ * @brief Map a signed integer to an unsigned key with the same ordering
+ *        by flipping its sign bit
+ */
+static inline
+uint32_t radix_key(int x)
+{
+    return (uint32_t)x ^ 0x80000000u;
+}
+
+/**
+ * @brief Turn the digit histograms into exclusive prefix sums (bucket start offsets)
+ * 
+ * @param hist RADIX_PASSES x RADIX_BUCKETS array of digit counters
+ * @param n    number of elements
+ * @return bit mask with bit d set if pass d has to be performed
+ */
+static
+int radix_offsets(size_t hist[RADIX_PASSES][RADIX_BUCKETS], size_t n)
+{
+    int passes = 0;
+
+    for(int d = 0; d < RADIX_PASSES; d++)
+    {
+        size_t sum = 0;
+        bool   skip = false;
+
+        for(int b = 0; b < RADIX_BUCKETS; b++)
+        {
+            size_t c = hist[d][b];
+
+            //every key has the same digit, the pass would be an identity copy
+            if(c == n)
+                skip = true;
+
+            hist[d][b] = sum;
+            sum += c;
+        }
+
+        if(!skip)
+            passes |= 1 << d;
+    }
+
+    return passes;
+}
+
+/**
+ * @brief In-place MSD radix sort over 8-bit digits, from the digit at shift down. 
+ *        Every bucket that fits the int indices of quicksort is finished by it, so 
+ *        only arrays longer than INT_MAX are split here. Used when the radix sort 
+ *        buffers cannot be allocated
+ */
+static
+void int_sort_in_place(int* a, size_t n, int shift)
+{
+    size_t start[257] = {0}, next[256];
+
+    if(n <= INT_MAX)
+    {
+        quicksort(a, 0, (int)n - 1);
+        return;
+    }
+
+    //every digit matched, all the values are equal
+    if(shift < 0)
+        return;
+
+    for(size_t i = 0; i < n; i++)
+        start[((radix_key(a[i]) >> shift) & 0xFF) + 1]++;
+    for(int b = 0; b < 256; b++)
+    {
+        start[b + 1] += start[b];
+        next[b] = start[b];
+    }
+
+    //move each value to the next free slot of its bucket, taking back the one found there
+    for(int b = 0; b < 256; b++)
+    {
+        while(next[b] < start[b + 1])
+        {
+            int x = a[next[b]];
+            int d = (radix_key(x) >> shift) & 0xFF;
+
+            if(d == b)
+            {
+                next[b]++;
+                continue;
+            }
+
+            a[next[b]] = a[next[d]];
+            a[next[d]++] = x;
+        }
+    }
+
+    for(int b = 0; b < 256; b++)
+        int_sort_in_place(a + start[b], start[b + 1] - start[b], shift - 8);
+}
+
+/**
+ * @brief Reverse the pairs a[lo,...,hi-1]
+ */
+static
+void kv_reverse(key_value_t* a, size_t lo, size_t hi)
+{
+    while(lo + 1 < hi)
+    {
+        key_value_t t = a[lo];
+        a[lo++] = a[--hi];
+        a[hi] = t;
+    }
+}
+
+/**
+ * @brief Stable merge of the ordered runs a[lo,...,mid-1] and a[mid,...,hi-1] without 
+ *        extra memory: the middle of the longer run is located in the other one, the 
+ *        two blocks between the cuts are swapped by rotation and each side is merged 
+ *        recursively, in Θ(nlogn) time
+ */
+static
+void kv_merge_in_place(key_value_t* a, size_t lo, size_t mid, size_t hi)
+{
+    size_t cut1, cut2, l, h;
+
+    if(lo == mid || mid == hi)
+        return;
+
+    if(mid - lo == 1 && hi - mid == 1)
+    {
+        if(a[mid].value < a[lo].value)
+            kv_reverse(a, lo, hi);
+        return;
+    }
+
+    if(mid - lo > hi - mid)
+    {
+        //first pair of the right run not smaller than a[cut1]
+        cut1 = lo + (mid - lo) / 2;
+        for(l = mid, h = hi; l < h; )
+        {
+            size_t m = l + (h - l) / 2;
+
+            if(a[m].value < a[cut1].value)
+                l = m + 1;
+            else
+                h = m;
+        }
+        cut2 = l;
+    }
+    else
+    {
+        //first pair of the left run bigger than a[cut2]
+        cut2 = mid + (hi - mid) / 2;
+        for(l = lo, h = mid; l < h; )
+        {
+            size_t m = l + (h - l) / 2;
+
+            if(a[m].value <= a[cut2].value)
+                l = m + 1;
+            else
+                h = m;
+        }
+        cut1 = l;
+    }
+
+    //rotate a[cut1,...,mid-1] past a[mid,...,cut2-1]
+    kv_reverse(a, cut1, mid);
+    kv_reverse(a, mid, cut2);
+    kv_reverse(a, cut1, cut2);
+
+    mid = cut1 + (cut2 - mid);
+    kv_merge_in_place(a, lo, cut1, mid);
+    kv_merge_in_place(a, mid, cut2, hi);
+}
+
+/**
+ * @brief Stable sort of key-value pairs by value with no extra memory, in Θ(nlog²n) time.
+ *        Used when the radix sort buffers cannot be allocated
+ */
+static
+void kv_stable_sort(key_value_t* a, size_t n)
+{
+    for(size_t lo = 0; lo < n; lo += KV_RUN)
+    {
+        size_t hi = (lo + KV_RUN < n) ? lo + KV_RUN : n;
+
+        for(size_t i = lo + 1; i < hi; i++)
+        {
+            key_value_t x = a[i];
+            size_t j = i;
+
+            for(; j > lo && a[j-1].value > x.value; j--)
+                a[j] = a[j-1];
+            a[j] = x;
+        }
+    }
+
+    for(size_t w = KV_RUN; w < n; w *= 2)
+    {
+        for(size_t lo = 0; lo + w < n; lo += 2*w)
+            kv_merge_in_place(a, lo, lo + w, (lo + 2*w < n) ? lo + 2*w : n);
+    }
+}
+
+/**
+ * @brief Sort an array of integers in ascending order with Θ(n) time complexity 
+ *        using LSD radix sort over 11-bit digits
+ * 
+ * @param a pointer to array to be sorted
+ * @param n size of the array to be sorted
+ */
+void radix_sort(int* a, size_t n)
+{
+    size_t (*hist)[RADIX_BUCKETS];
+    int *src, *dst, *tmp;
+    int passes;
+
+    if(a == NULL || n < 2)
+        return;
+
+    hist = calloc(RADIX_PASSES, sizeof(*hist));
+    tmp = malloc(n * sizeof(int));
+    if(hist == NULL || tmp == NULL)
+    {
+        free(hist);
+        free(tmp);
+
+        //no scratch memory, sort in place instead
+        int_sort_in_place(a, n, 24);
+        return;
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+        uint32_t k = radix_key(a[i]);
+        hist[0][k & RADIX_MASK]++;
+        hist[1][(k >> RADIX_BITS) & RADIX_MASK]++;
+        hist[2][k >> (2*RADIX_BITS)]++;
+    }
+
+    passes = radix_offsets(hist, n);
+
+    src = a;
+    dst = tmp;
+    for(int d = 0; d < RADIX_PASSES; d++)
+    {
+        if(!(passes & (1 << d)))
+            continue;
+
+        int shift = d * RADIX_BITS;
+        size_t* off = hist[d];
+
+        for(size_t i = 0; i < n; i++)
+        {
+            uint32_t b = (radix_key(src[i]) >> shift) & RADIX_MASK;
+            dst[off[b]++] = src[i];
+        }
+
+        int* swp = src;
+        src = dst;
+        dst = swp;
+    }
+
+    if(src != a)
+        memcpy(a, src, n * sizeof(int));
+
+    free(tmp);
+    free(hist);
+}
+
+/**
+ * @brief Stable sort of an array of key-value pairs in ascending order of value 
+ *        with Θ(n) time complexity using LSD radix sort over 11-bit digits
+ * 
+ * @param a pointer to array of pairs to be sorted
+ * @param n size of the array to be sorted
+ */
+void radix_sort_kv(key_value_t* a, size_t n)
+{
+    size_t (*hist)[RADIX_BUCKETS];
+    key_value_t *src, *dst, *tmp;
+    int passes;
+
+    if(a == NULL || n < 2)
+        return;
+
+    hist = calloc(RADIX_PASSES, sizeof(*hist));
+    tmp = malloc(n * sizeof(key_value_t));
+    if(hist == NULL || tmp == NULL)
+    {
+        free(hist);
+        free(tmp);
+
+        //no scratch memory, sort in place and still keep equal values in order
+        kv_stable_sort(a, n);
+        return;
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+        uint32_t k = radix_key(a[i].value);
+        hist[0][k & RADIX_MASK]++;
+        hist[1][(k >> RADIX_BITS) & RADIX_MASK]++;
+        hist[2][k >> (2*RADIX_BITS)]++;
+    }
+
+    passes = radix_offsets(hist, n);
+
+    src = a;
+    dst = tmp;
+    for(int d = 0; d < RADIX_PASSES; d++)
+    {
+        if(!(passes & (1 << d)))
+            continue;
+
+        int shift = d * RADIX_BITS;
+        size_t* off = hist[d];
+
+        for(size_t i = 0; i < n; i++)
+        {
+            uint32_t b = (radix_key(src[i].value) >> shift) & RADIX_MASK;
+            dst[off[b]++] = src[i];
+        }
+
+        key_value_t* swp = src;
+        src = dst;
+        dst = swp;
+    }
+
+    if(src != a)
+        memcpy(a, src, n * sizeof(key_value_t));
+
+    free(tmp);
+    free(hist);
+}
@@ -0,0 +1,508 @@
+/**
+ * @file    sortnet.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include "../inc/sortnet.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORTNET_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Sort a small array in ascending order by insertion
+ * 
+ * @param a pointer to array
+ * @param n size of array
+ */
+static
+void insertion_sort(int* a, int n)
+{
+    for(int i = 1; i < n; i++)
+    {
+        int key = a[i];
+        int j = i-1;
+
+        while(j >= 0 && a[j] > key)
+        {
+            a[j+1] = a[j];
+            j--;
+        }
+        a[j+1] = key;
+    }
+}
+
+/**
+ * @brief Scalar merge of two ordered arrays. On equal keys elements of x come first.
+ */
+static
+void scalar_merge(const int* x, int nx, const int* y, int ny, int* out)
+{
+    int i = 0, j = 0, k = 0;
+
+    while(i < nx && j < ny)
+    {
+        if(y[j] < x[i])
+            out[k++] = y[j++];
+        else
+            out[k++] = x[i++];
+    }
+
+    while(i < nx)
+        out[k++] = x[i++];
+
+    while(j < ny)
+        out[k++] = y[j++];
+}
+
+#ifdef SORTNET_X86
+
+/**
+ * @brief Scalar merge of three ordered arrays, used to finish a vectorized merge 
+ *        with the register still in flight and the tails of both inputs
+ */
+static
+void scalar_merge3(const int* a, int na, const int* x, int nx, const int* y, int ny, int* out)
+{
+    int h = 0, i = 0, j = 0, k = 0;
+
+    while(h < na)
+    {
+        if(i < nx && x[i] <= a[h] && (j >= ny || x[i] <= y[j]))
+            out[k++] = x[i++];
+        else if(j < ny && y[j] < a[h])
+            out[k++] = y[j++];
+        else
+            out[k++] = a[h++];
+    }
+
+    scalar_merge(x + i, nx - i, y + j, ny - j, out + k);
+}
+
+#define AVX2    __attribute__((target("avx2")))
+#define SSE41   __attribute__((target("sse4.1")))
+
+/*
+ * Compare-exchange every lane of v with the lane of its permutation p,
+ * keeping the maximum on the lanes set in mask and the minimum on the others
+ */
+#define AVX2_CE(v, p, mask) \
+    _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), mask)
+
+#define SSE41_CE(v, p, mask) \
+    _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(_mm_min_epi32(v, p)), \
+                                  _mm_castsi128_ps(_mm_max_epi32(v, p)), mask))
+
+AVX2 static inline __m256i avx2_swap1(__m256i v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)); }
+AVX2 static inline __m256i avx2_swap2(__m256i v) { return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)); }
+AVX2 static inline __m256i avx2_swap4(__m256i v) { return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1,0,3,2)); }
+
+AVX2 static inline 
+__m256i avx2_reverse(__m256i v) 
+{ 
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7,6,5,4,3,2,1,0));
+}
+
+/**
+ * @brief Sort a bitonic register in ascending order (half-cleaners at distance 4, 2 and 1)
+ */
+AVX2 static inline
+__m256i avx2_clean8(__m256i v)
+{
+    v = AVX2_CE(v, avx2_swap4(v), 0xF0);
+    v = AVX2_CE(v, avx2_swap2(v), 0xCC);
+    v = AVX2_CE(v, avx2_swap1(v), 0xAA);
+
+    return v;
+}
+
+/**
+ * @brief Sort the 8 lanes of a register in ascending order
+ */
+AVX2 static inline
+__m256i avx2_sort8(__m256i v)
+{
+    v = AVX2_CE(v, avx2_swap1(v), 0x66);
+    v = AVX2_CE(v, avx2_swap2(v), 0x3C);
+    v = AVX2_CE(v, avx2_swap1(v), 0x5A);
+
+    return avx2_clean8(v);
+}
+
+/**
+ * @brief Sort a bitonic sequence held in n registers in ascending order
+ */
+AVX2 static inline
+void avx2_merge_regs(__m256i* r, int n)
+{
+    for(int d = n/2; d >= 1; d /= 2)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            if(i & d)
+                continue;
+
+            __m256i lo = _mm256_min_epi32(r[i], r[i+d]);
+            r[i+d] = _mm256_max_epi32(r[i], r[i+d]);
+            r[i] = lo;
+        }
+    }
+
+    for(int i = 0; i < n; i++)
+        r[i] = avx2_clean8(r[i]);
+}
+
+/**
+ * @brief Sort 8n integers held in n registers (n = 1, 2, 4 or 8) in ascending order
+ */
+AVX2 static inline
+void avx2_sort_regs(__m256i* r, int n)
+{
+    for(int i = 0; i < n; i++)
+        r[i] = avx2_sort8(r[i]);
+
+    for(int m = 1; m < n; m *= 2)
+    {
+        for(int b = 0; b < n; b += 2*m)
+        {
+            //reverse the second run so both runs form a single bitonic sequence
+            for(int i = 0; i < m/2; i++)
+            {
+                __m256i t = r[b+m+i];
+                r[b+m+i] = r[b+2*m-1-i];
+                r[b+2*m-1-i] = t;
+            }
+            for(int i = 0; i < m; i++)
+                r[b+m+i] = avx2_reverse(r[b+m+i]);
+
+            avx2_merge_regs(r + b, 2*m);
+        }
+    }
+}
+
+AVX2 static
+void avx2_sort(int* a, int n)
+{
+    __m256i r[SORTNET_MAX/8];
+    int buf[SORTNET_MAX];
+    int nregs = 1;
+
+    while(8*nregs < n)
+        nregs *= 2;
+
+    for(int i = 0; i < n; i++)
+        buf[i] = a[i];
+    for(int i = n; i < 8*nregs; i++)
+        buf[i] = INT_MAX;
+
+    for(int i = 0; i < nregs; i++)
+        r[i] = _mm256_loadu_si256((__m256i*)(buf + 8*i));
+
+    avx2_sort_regs(r, nregs);
+
+    for(int i = 0; i < nregs; i++)
+        _mm256_storeu_si256((__m256i*)(buf + 8*i), r[i]);
+
+    for(int i = 0; i < n; i++)
+        a[i] = buf[i];
+}
+
+/**
+ * @brief Merge two ordered registers. lo receives the 8 smallest elements
+ *        and hi the 8 biggest, both in ascending order
+ */
+AVX2 static inline
+void avx2_merge16(__m256i* lo, __m256i* hi)
+{
+    __m256i r = avx2_reverse(*hi);
+    __m256i l = _mm256_min_epi32(*lo, r);
+    __m256i h = _mm256_max_epi32(*lo, r);
+
+    *lo = avx2_clean8(l);
+    *hi = avx2_clean8(h);
+}
+
+AVX2 static
+void avx2_merge(const int* x, int nx, const int* y, int ny, int* out)
+{
+    __m256i lo, hi;
+    int rest[8];
+    int i = 8, j = 8, k = 8;
+
+    if(nx < 8 || ny < 8)
+    {
+        scalar_merge(x, nx, y, ny, out);
+        return;
+    }
+
+    lo = _mm256_loadu_si256((const __m256i*)x);
+    hi = _mm256_loadu_si256((const __m256i*)y);
+    avx2_merge16(&lo, &hi);
+    _mm256_storeu_si256((__m256i*)out, lo);
+
+    //the register in flight always holds the 8 biggest elements seen so far,
+    //so the next block must come from the input with the smaller head
+    for(;;)
+    {
+        if(i < nx && (j >= ny || x[i] <= y[j]))
+        {
+            if(i + 8 > nx)
+                break;
+            lo = _mm256_loadu_si256((const __m256i*)(x + i));
+            i += 8;
+        }
+        else if(j < ny)
+        {
+            if(j + 8 > ny)
+                break;
+            lo = _mm256_loadu_si256((const __m256i*)(y + j));
+            j += 8;
+        }
+        else
+        {
+            break;
+        }
+
+        avx2_merge16(&lo, &hi);
+        _mm256_storeu_si256((__m256i*)(out + k), lo);
+        k += 8;
+    }
+
+    _mm256_storeu_si256((__m256i*)rest, hi);
+    scalar_merge3(rest, 8, x + i, nx - i, y + j, ny - j, out + k);
+}
+
+SSE41 static inline __m128i sse41_swap1(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)); }
+SSE41 static inline __m128i sse41_swap2(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)); }
+SSE41 static inline __m128i sse41_reverse(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3)); }
+
+/**
+ * @brief Sort a bitonic register in ascending order (half-cleaners at distance 2 and 1)
+ */
+SSE41 static inline
+__m128i sse41_clean4(__m128i v)
+{
+    v = SSE41_CE(v, sse41_swap2(v), 0xC);
+    v = SSE41_CE(v, sse41_swap1(v), 0xA);
+
+    return v;
+}
+
+/**
+ * @brief Sort the 4 lanes of a register in ascending order
+ */
+SSE41 static inline
+__m128i sse41_sort4(__m128i v)
+{
+    v = SSE41_CE(v, sse41_swap1(v), 0x6);
+
+    return sse41_clean4(v);
+}
+
+/**
+ * @brief Sort a bitonic sequence held in n registers in ascending order
+ */
+SSE41 static inline
+void sse41_merge_regs(__m128i* r, int n)
+{
+    for(int d = n/2; d >= 1; d /= 2)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            if(i & d)
+                continue;
+
+            __m128i lo = _mm_min_epi32(r[i], r[i+d]);
+            r[i+d] = _mm_max_epi32(r[i], r[i+d]);
+            r[i] = lo;
+        }
+    }
+
+    for(int i = 0; i < n; i++)
+        r[i] = sse41_clean4(r[i]);
+}
+
+/**
+ * @brief Sort 4n integers held in n registers (n = 2, 4, 8 or 16) in ascending order
+ */
+SSE41 static inline
+void sse41_sort_regs(__m128i* r, int n)
+{
+    for(int i = 0; i < n; i++)
+        r[i] = sse41_sort4(r[i]);
+
+    for(int m = 1; m < n; m *= 2)
+    {
+        for(int b = 0; b < n; b += 2*m)
+        {
+            //reverse the second run so both runs form a single bitonic sequence
+            for(int i = 0; i < m/2; i++)
+            {
+                __m128i t = r[b+m+i];
+                r[b+m+i] = r[b+2*m-1-i];
+                r[b+2*m-1-i] = t;
+            }
+            for(int i = 0; i < m; i++)
+                r[b+m+i] = sse41_reverse(r[b+m+i]);
+
+            sse41_merge_regs(r + b, 2*m);
+        }
+    }
+}
+
+SSE41 static
+void sse41_sort(int* a, int n)
+{
+    __m128i r[SORTNET_MAX/4];
+    int buf[SORTNET_MAX];
+    int nregs = 2;
+
+    while(4*nregs < n)
+        nregs *= 2;
+
+    for(int i = 0; i < n; i++)
+        buf[i] = a[i];
+    for(int i = n; i < 4*nregs; i++)
+        buf[i] = INT_MAX;
+
+    for(int i = 0; i < nregs; i++)
+        r[i] = _mm_loadu_si128((__m128i*)(buf + 4*i));
+
+    sse41_sort_regs(r, nregs);
+
+    for(int i = 0; i < nregs; i++)
+        _mm_storeu_si128((__m128i*)(buf + 4*i), r[i]);
+
+    for(int i = 0; i < n; i++)
+        a[i] = buf[i];
+}
+
+/**
+ * @brief Merge two ordered registers. lo receives the 4 smallest elements
+ *        and hi the 4 biggest, both in ascending order
+ */
+SSE41 static inline
+void sse41_merge8(__m128i* lo, __m128i* hi)
+{
+    __m128i r = sse41_reverse(*hi);
+    __m128i l = _mm_min_epi32(*lo, r);
+    __m128i h = _mm_max_epi32(*lo, r);
+
+    *lo = sse41_clean4(l);
+    *hi = sse41_clean4(h);
+}
+
+SSE41 static
+void sse41_merge(const int* x, int nx, const int* y, int ny, int* out)
+{
+    __m128i lo, hi;
+    int rest[4];
+    int i = 4, j = 4, k = 4;
+
+    if(nx < 4 || ny < 4)
+    {
+        scalar_merge(x, nx, y, ny, out);
+        return;
+    }
+
+    lo = _mm_loadu_si128((const __m128i*)x);
+    hi = _mm_loadu_si128((const __m128i*)y);
+    sse41_merge8(&lo, &hi);
+    _mm_storeu_si128((__m128i*)out, lo);
+
+    for(;;)
+    {
+        if(i < nx && (j >= ny || x[i] <= y[j]))
+        {
+            if(i + 4 > nx)
+                break;
+            lo = _mm_loadu_si128((const __m128i*)(x + i));
+            i += 4;
+        }
+        else if(j < ny)
+        {
+            if(j + 4 > ny)
+                break;
+            lo = _mm_loadu_si128((const __m128i*)(y + j));
+            j += 4;
+        }
+        else
+        {
+            break;
+        }
+
+        sse41_merge8(&lo, &hi);
+        _mm_storeu_si128((__m128i*)(out + k), lo);
+        k += 4;
+    }
+
+    _mm_storeu_si128((__m128i*)rest, hi);
+    scalar_merge3(rest, 4, x + i, nx - i, y + j, ny - j, out + k);
+}
+
+#endif //SORTNET_X86
+
+int simd_level(void)
+{
+#ifdef SORTNET_X86
+    if(__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+
+    if(__builtin_cpu_supports("sse4.1"))
+        return SIMD_SSE41;
+#endif
+    return SIMD_NONE;
+}
+
+void sortnet_sort(int* a, int n)
+{
+    if(a == NULL || n < 2)
+        return;
+
+    if(n > SORTNET_MAX)
+    {
+        insertion_sort(a, n);
+        return;
+    }
+
+    switch(simd_level())
+    {
+#ifdef SORTNET_X86
+        case SIMD_AVX2:
+            avx2_sort(a, n);
+        break;
+
+        case SIMD_SSE41:
+            sse41_sort(a, n);
+        break;
+#endif
+        default:
+            insertion_sort(a, n);
+        break;
+    }
+}
+
+void sortnet_merge(const int* x, int nx, const int* y, int ny, int* out)
+{
+    switch(simd_level())
+    {
+#ifdef SORTNET_X86
+        case SIMD_AVX2:
+            avx2_merge(x, nx, y, ny, out);
+        break;
+
+        case SIMD_SSE41:
+            sse41_merge(x, nx, y, ny, out);
+        break;
+#endif
+        default:
+            scalar_merge(x, nx, y, ny, out);
+        break;
+    }
+}
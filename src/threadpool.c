@@ -0,0 +1,260 @@
+/**
+ * @file    threadpool.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "../inc/threadpool.h"
+
+#define POOL_INITIAL_TASKS  64
+
+/**
+ * @brief Take the oldest task from the queue. Must be called with the pool lock held.
+ * 
+ * @param pool pointer to pool
+ * @param task returns the task
+ * @return true if a task was taken, false if the queue is empty
+ */
+static
+bool pop_task(pool_t* pool, task_t* task)
+{
+    if(!pool->ctr)
+        return false;
+
+    *task = pool->tasks[pool->head];
+    pool->head = (pool->head + 1) % pool->size;
+    pool->ctr--;
+
+    return true;
+}
+
+/**
+ * @brief Run a task outside the lock and notify its group. 
+ *        Must be called with the pool lock held.
+ * 
+ * @param pool pointer to pool
+ * @param task task to run
+ */
+static
+void run_task(pool_t* pool, task_t* task)
+{
+    pthread_mutex_unlock(&pool->lock);
+    task->fn(task->arg);
+    pthread_mutex_lock(&pool->lock);
+
+    if(--task->group->pending == 0)
+        pthread_cond_broadcast(&pool->cond);
+}
+
+static
+void* worker(void* arg)
+{
+    pool_t* pool = arg;
+    task_t task;
+
+    pthread_mutex_lock(&pool->lock);
+    while(!pool->stop)
+    {
+        if(pop_task(pool, &task))
+            run_task(pool, &task);
+        else
+            pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int pool_cpus(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (n > 0) ? (int)n : 1;
+}
+
+pool_t* pool_create(int nthreads)
+{
+    pool_t* pool = malloc(sizeof(pool_t));
+
+    if(pool == NULL)
+        return NULL;
+
+    if(nthreads <= 0)
+        nthreads = pool_cpus();
+
+    pool->nthreads = nthreads;
+    pool->size = POOL_INITIAL_TASKS;
+    pool->head = 0;
+    pool->ctr = 0;
+    pool->stop = false;
+    pool->tasks = malloc(pool->size * sizeof(task_t));
+    pool->threads = malloc(nthreads * sizeof(pthread_t));
+
+    if(pool->tasks == NULL || pool->threads == NULL)
+    {
+        free(pool->tasks);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    for(int i = 1; i < nthreads; i++)
+    {
+        if(pthread_create(&pool->threads[i], NULL, worker, pool) != 0)
+        {
+            //run with the threads we managed to start
+            pool->nthreads = i;
+            break;
+        }
+    }
+
+    return pool;
+}
+
+void pool_destroy(pool_t* pool)
+{
+    if(pool == NULL)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int i = 1; i < pool->nthreads; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->cond);
+
+    free(pool->threads);
+    free(pool->tasks);
+    free(pool);
+}
+
+void pool_submit(pool_t* pool, group_t* group, task_fn_t fn, void* arg)
+{
+    pthread_mutex_lock(&pool->lock);
+
+    if(pool->ctr == pool->size)
+    {
+        //grow the ring and unwrap it at the same time
+        task_t* tasks = malloc(2 * pool->size * sizeof(task_t));
+
+        if(tasks == NULL)
+        {
+            //no room to queue it, run it here instead
+            pthread_mutex_unlock(&pool->lock);
+            fn(arg);
+            return;
+        }
+
+        for(int i = 0; i < pool->ctr; i++)
+            tasks[i] = pool->tasks[(pool->head + i) % pool->size];
+
+        free(pool->tasks);
+        pool->tasks = tasks;
+        pool->head = 0;
+        pool->size *= 2;
+    }
+
+    task_t* t = &pool->tasks[(pool->head + pool->ctr) % pool->size];
+    t->fn = fn;
+    t->arg = arg;
+    t->group = group;
+    pool->ctr++;
+    group->pending++;
+
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void pool_wait(pool_t* pool, group_t* group)
+{
+    task_t task;
+
+    pthread_mutex_lock(&pool->lock);
+    while(group->pending)
+    {
+        if(pop_task(pool, &task))
+            run_task(pool, &task);
+        else
+            pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Block of iterations of a parallel for loop
+ * 
+ */
+typedef struct for_block_s
+{
+    int lo;
+    int hi;
+    void (*fn)(int lo, int hi, void* ctx);
+    void* ctx;
+
+}for_block_t;
+
+static
+void run_block(void* arg)
+{
+    for_block_t* b = arg;
+
+    b->fn(b->lo, b->hi, b->ctx);
+}
+
+void pool_parallel_for(pool_t* pool, int n, int grain, void (*fn)(int lo, int hi, void* ctx), void* ctx)
+{
+    group_t group = {0};
+    int nblocks;
+
+    if(n <= 0)
+        return;
+
+    if(grain < 1)
+        grain = 1;
+
+    //a few blocks per thread so uneven blocks still balance
+    nblocks = 4 * pool->nthreads;
+    if(nblocks > (n + grain - 1) / grain)
+        nblocks = (n + grain - 1) / grain;
+
+    if(nblocks <= 1)
+    {
+        fn(0, n, ctx);
+        return;
+    }
+
+    for_block_t* blocks = malloc(nblocks * sizeof(for_block_t));
+    if(blocks == NULL)
+    {
+        fn(0, n, ctx);
+        return;
+    }
+
+    for(int i = 0; i < nblocks; i++)
+    {
+        blocks[i].lo = (int)((long long)n * i / nblocks);
+        blocks[i].hi = (int)((long long)n * (i+1) / nblocks);
+        blocks[i].fn = fn;
+        blocks[i].ctx = ctx;
+    }
+
+    //the calling thread takes the first block itself
+    for(int i = 1; i < nblocks; i++)
+        pool_submit(pool, &group, run_block, &blocks[i]);
+
+    run_block(&blocks[0]);
+    pool_wait(pool, &group);
+
+    free(blocks);
+}
@@ -0,0 +1,637 @@
+/**
+ * @file    timsort.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../inc/sort.h"
+
+// arrays shorter than this are sorted by binary insertion alone
+#define MIN_MERGE       64
+
+// consecutive wins of one run before switching to galloping mode
+#define MIN_GALLOP      7
+
+// enough pending runs for any array of up to 2^64 elements
+#define MAX_RUNS        85
+
+/**
+ * @brief A pending run a[base,...,base+len-1] already sorted
+ * 
+ */
+typedef struct run_s
+{
+    int base;
+    int len;
+
+}run_t;
+
+/**
+ * @brief State of one timsort call
+ * 
+ */
+typedef struct timsort_s
+{
+    int*    a;
+    int*    tmp;            // scratch buffer for merges, allocated once on the first merge
+    int     tmp_size;
+    int     min_gallop;     // adapts to how often galloping pays off
+
+    run_t   runs[MAX_RUNS];
+    int     nruns;
+
+}timsort_t;
+
+/**
+ * @brief Length of the run starting at a[lo], reversing it in place if it is strictly descending
+ * 
+ * @param a pointer to array
+ * @param lo first index of the run
+ * @param hi one past the last index that may belong to the run
+ * @return length of the run
+ */
+static
+int count_run(int* a, int lo, int hi)
+{
+    int r = lo + 1;
+
+    if(r == hi)
+        return 1;
+
+    if(a[r] < a[lo])
+    {
+        //strictly descending, so reversing it keeps equal keys in order
+        while(r + 1 < hi && a[r+1] < a[r])
+            r++;
+
+        for(int i = lo, j = r; i < j; i++, j--)
+        {
+            int aux = a[i];
+            a[i] = a[j];
+            a[j] = aux;
+        }
+    }
+    else
+    {
+        while(r + 1 < hi && a[r+1] >= a[r])
+            r++;
+    }
+
+    return r - lo + 1;
+}
+
+/**
+ * @brief Sort a[lo,...,hi-1] by binary insertion, knowing that a[lo,...,start-1] is already sorted
+ */
+static
+void binary_insertion_sort(int* a, int lo, int hi, int start)
+{
+    for(int i = start; i < hi; i++)
+    {
+        int key = a[i];
+        int l = lo;
+        int r = i;
+
+        //insert after any equal keys
+        while(l < r)
+        {
+            int m = l + (r - l) / 2;
+
+            if(key < a[m])
+                r = m;
+            else
+                l = m + 1;
+        }
+
+        memmove(a + l + 1, a + l, (i - l) * sizeof(int));
+        a[l] = key;
+    }
+}
+
+/**
+ * @brief Minimum run length, chosen so that n/minrun is a power of two or slightly less
+ */
+static
+int min_run_length(int n)
+{
+    int r = 0;
+
+    while(n >= MIN_MERGE)
+    {
+        r |= n & 1;
+        n >>= 1;
+    }
+
+    return n + r;
+}
+
+/**
+ * @brief Position where key would be inserted before any equal elements of the 
+ *        ordered array a[0,...,n-1]. Gallops from a[hint] in steps of 1, 3, 7, ... 
+ *        and finishes with a binary search, so the cost is O(log d) where d is the 
+ *        distance from the hint.
+ * 
+ * @return k such that a[k-1] < key <= a[k]
+ */
+static
+int gallop_left(int key, const int* a, int n, int hint)
+{
+    int last = 0;
+    int ofs = 1;
+    int max, aux;
+
+    if(a[hint] < key)
+    {
+        //a[hint+last] < key <= a[hint+ofs]
+        max = n - hint;
+        while(ofs < max && a[hint+ofs] < key)
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0)
+                ofs = max;
+        }
+        if(ofs > max)
+            ofs = max;
+
+        last += hint;
+        ofs += hint;
+    }
+    else
+    {
+        //a[hint-ofs] < key <= a[hint-last]
+        max = hint + 1;
+        while(ofs < max && !(a[hint-ofs] < key))
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0)
+                ofs = max;
+        }
+        if(ofs > max)
+            ofs = max;
+
+        aux = last;
+        last = hint - ofs;
+        ofs = hint - aux;
+    }
+
+    //a[last] < key <= a[ofs]
+    last++;
+    while(last < ofs)
+    {
+        int m = last + (ofs - last) / 2;
+
+        if(a[m] < key)
+            last = m + 1;
+        else
+            ofs = m;
+    }
+
+    return ofs;
+}
+
+/**
+ * @brief Like gallop_left(), but key is inserted after any equal elements
+ * 
+ * @return k such that a[k-1] <= key < a[k]
+ */
+static
+int gallop_right(int key, const int* a, int n, int hint)
+{
+    int last = 0;
+    int ofs = 1;
+    int max, aux;
+
+    if(key < a[hint])
+    {
+        //a[hint-ofs] <= key < a[hint-last]
+        max = hint + 1;
+        while(ofs < max && key < a[hint-ofs])
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0)
+                ofs = max;
+        }
+        if(ofs > max)
+            ofs = max;
+
+        aux = last;
+        last = hint - ofs;
+        ofs = hint - aux;
+    }
+    else
+    {
+        //a[hint+last] <= key < a[hint+ofs]
+        max = n - hint;
+        while(ofs < max && !(key < a[hint+ofs]))
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0)
+                ofs = max;
+        }
+        if(ofs > max)
+            ofs = max;
+
+        last += hint;
+        ofs += hint;
+    }
+
+    //a[last] <= key < a[ofs]
+    last++;
+    while(last < ofs)
+    {
+        int m = last + (ofs - last) / 2;
+
+        if(key < a[m])
+            ofs = m;
+        else
+            last = m + 1;
+    }
+
+    return ofs;
+}
+
+/**
+ * @brief Make sure the scratch buffer holds at least n elements
+ * 
+ * @return false if the allocation failed
+ */
+static
+bool reserve_tmp(timsort_t* ts, int n)
+{
+    if(ts->tmp_size >= n)
+        return true;
+
+    free(ts->tmp);
+    ts->tmp = malloc(n * sizeof(int));
+    ts->tmp_size = ts->tmp ? n : 0;
+
+    return ts->tmp != NULL;
+}
+
+/**
+ * @brief Merge two adjacent runs in place, copying the shorter left run to the 
+ *        scratch buffer and filling the array from the left.
+ *        The first element of run 2 must be smaller than the first of run 1, 
+ *        and the last element of run 1 bigger than every element of run 2.
+ */
+static
+void merge_lo(timsort_t* ts, int base1, int len1, int base2, int len2)
+{
+    int* a = ts->a;
+    int* tmp = ts->tmp;
+    int dest = base1;
+    int c1 = 0;             // cursor on run 1, copied to tmp
+    int c2 = base2;         // cursor on run 2
+    int min_gallop = ts->min_gallop;
+    int count1, count2;
+
+    memcpy(tmp, a + base1, len1 * sizeof(int));
+
+    a[dest++] = a[c2++];
+    if(--len2 == 0)
+        goto copy_run1;
+    if(len1 == 1)
+        goto copy_run2;
+
+    for(;;)
+    {
+        count1 = 0;
+        count2 = 0;
+
+        //one element at a time until a run wins min_gallop times in a row
+        do
+        {
+            if(a[c2] < tmp[c1])
+            {
+                a[dest++] = a[c2++];
+                count2++;
+                count1 = 0;
+                if(--len2 == 0)
+                    goto copy_run1;
+            }
+            else
+            {
+                a[dest++] = tmp[c1++];
+                count1++;
+                count2 = 0;
+                if(--len1 == 1)
+                    goto copy_run2;
+            }
+        }while((count1 | count2) < min_gallop);
+
+        //galloping: copy whole blocks found by exponential search
+        do
+        {
+            count1 = gallop_right(a[c2], tmp + c1, len1, 0);
+            if(count1)
+            {
+                memcpy(a + dest, tmp + c1, count1 * sizeof(int));
+                dest += count1;
+                c1 += count1;
+                len1 -= count1;
+                if(len1 <= 1)
+                    goto copy_run2;
+            }
+            a[dest++] = a[c2++];
+            if(--len2 == 0)
+                goto copy_run1;
+
+            count2 = gallop_left(tmp[c1], a + c2, len2, 0);
+            if(count2)
+            {
+                memmove(a + dest, a + c2, count2 * sizeof(int));
+                dest += count2;
+                c2 += count2;
+                len2 -= count2;
+                if(len2 == 0)
+                    goto copy_run1;
+            }
+            a[dest++] = tmp[c1++];
+            if(--len1 == 1)
+                goto copy_run2;
+
+            min_gallop--;
+        }while(count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+        if(min_gallop < 0)
+            min_gallop = 0;
+        min_gallop += 2;
+    }
+
+copy_run1:
+    memcpy(a + dest, tmp + c1, len1 * sizeof(int));
+    ts->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+    return;
+
+copy_run2:
+    //the last element of run 1 is bigger than everything left in run 2
+    memmove(a + dest, a + c2, len2 * sizeof(int));
+    a[dest + len2] = tmp[c1];
+    ts->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+}
+
+/**
+ * @brief Merge two adjacent runs in place, copying the shorter right run to the 
+ *        scratch buffer and filling the array from the right.
+ *        Same preconditions as merge_lo()
+ */
+static
+void merge_hi(timsort_t* ts, int base1, int len1, int base2, int len2)
+{
+    int* a = ts->a;
+    int* tmp = ts->tmp;
+    int dest = base2 + len2 - 1;
+    int c1 = base1 + len1 - 1;      // cursor on run 1
+    int min_gallop = ts->min_gallop;
+    int count1, count2;
+
+    //the cursor on run 2 is always tmp[len2-1]
+    memcpy(tmp, a + base2, len2 * sizeof(int));
+
+    a[dest--] = a[c1--];
+    if(--len1 == 0)
+        goto copy_run2;
+    if(len2 == 1)
+        goto copy_run1;
+
+    for(;;)
+    {
+        count1 = 0;
+        count2 = 0;
+
+        do
+        {
+            if(tmp[len2-1] < a[c1])
+            {
+                a[dest--] = a[c1--];
+                count1++;
+                count2 = 0;
+                if(--len1 == 0)
+                    goto copy_run2;
+            }
+            else
+            {
+                a[dest--] = tmp[len2-1];
+                count2++;
+                count1 = 0;
+                if(--len2 == 1)
+                    goto copy_run1;
+            }
+        }while((count1 | count2) < min_gallop);
+
+        do
+        {
+            count1 = len1 - gallop_right(tmp[len2-1], a + base1, len1, len1 - 1);
+            if(count1)
+            {
+                dest -= count1;
+                c1 -= count1;
+                len1 -= count1;
+                memmove(a + dest + 1, a + c1 + 1, count1 * sizeof(int));
+                if(len1 == 0)
+                    goto copy_run2;
+            }
+            a[dest--] = tmp[len2-1];
+            if(--len2 == 1)
+                goto copy_run1;
+
+            count2 = len2 - gallop_left(a[c1], tmp, len2, len2 - 1);
+            if(count2)
+            {
+                dest -= count2;
+                len2 -= count2;
+                memcpy(a + dest + 1, tmp + len2, count2 * sizeof(int));
+                if(len2 <= 1)
+                    goto copy_run1;
+            }
+            a[dest--] = a[c1--];
+            if(--len1 == 0)
+                goto copy_run2;
+
+            min_gallop--;
+        }while(count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+        if(min_gallop < 0)
+            min_gallop = 0;
+        min_gallop += 2;
+    }
+
+copy_run2:
+    memcpy(a + dest - (len2 - 1), tmp, len2 * sizeof(int));
+    ts->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+    return;
+
+copy_run1:
+    //the first element of run 2 is smaller than everything left in run 1
+    dest -= len1;
+    c1 -= len1;
+    memmove(a + dest + 1, a + c1 + 1, len1 * sizeof(int));
+    a[dest] = tmp[0];
+    ts->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+}
+
+/**
+ * @brief Merge the pending runs i and i+1
+ * 
+ * @return false if the scratch buffer could not be allocated
+ */
+static
+bool merge_at(timsort_t* ts, int i)
+{
+    int base1 = ts->runs[i].base;
+    int len1 = ts->runs[i].len;
+    int base2 = ts->runs[i+1].base;
+    int len2 = ts->runs[i+1].len;
+    int k;
+
+    ts->runs[i].len = len1 + len2;
+    if(i == ts->nruns - 3)
+        ts->runs[i+1] = ts->runs[i+2];
+    ts->nruns--;
+
+    //elements of run 1 not bigger than the head of run 2 are already in place
+    k = gallop_right(ts->a[base2], ts->a + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if(len1 == 0)
+        return true;
+
+    //and so are elements of run 2 not smaller than the tail of run 1
+    len2 = gallop_left(ts->a[base1 + len1 - 1], ts->a + base2, len2, len2 - 1);
+    if(len2 == 0)
+        return true;
+
+    if(!reserve_tmp(ts, (len1 < len2) ? len1 : len2))
+        return false;
+
+    if(len1 <= len2)
+        merge_lo(ts, base1, len1, base2, len2);
+    else
+        merge_hi(ts, base1, len1, base2, len2);
+
+    return true;
+}
+
+/**
+ * @brief Merge pending runs until the stack invariants hold again:
+ *        len[i-2] > len[i-1] + len[i] and len[i-1] > len[i], checked on the 
+ *        top four runs
+ */
+static
+bool merge_collapse(timsort_t* ts)
+{
+    run_t* r = ts->runs;
+
+    while(ts->nruns > 1)
+    {
+        int n = ts->nruns - 2;
+
+        if((n > 0 && r[n-1].len <= r[n].len + r[n+1].len) ||
+           (n > 1 && r[n-2].len <= r[n-1].len + r[n].len))
+        {
+            if(r[n-1].len < r[n+1].len)
+                n--;
+        }
+        else if(r[n].len > r[n+1].len)
+        {
+            break;
+        }
+
+        if(!merge_at(ts, n))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Merge all pending runs into one
+ */
+static
+bool merge_force_collapse(timsort_t* ts)
+{
+    run_t* r = ts->runs;
+
+    while(ts->nruns > 1)
+    {
+        int n = ts->nruns - 2;
+
+        if(n > 0 && r[n-1].len < r[n+1].len)
+            n--;
+
+        if(!merge_at(ts, n))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sort an array in ascending order with an adaptive, run-detecting mergesort (timsort).
+ *        Existing ascending and strictly descending runs are used as they are, so 
+ *        already sorted input costs O(n) and the worst case is Θ(nlogn)
+ * 
+ * @param a pointer to array to be sorted
+ * @param n size of the array to be sorted
+ */
+void timsort(int* a, int n)
+{
+    timsort_t ts;
+    int lo = 0;
+    int left = n;
+    int minrun;
+
+    if(a == NULL || n < 2)
+        return;
+
+    if(n < MIN_MERGE)
+    {
+        binary_insertion_sort(a, 0, n, count_run(a, 0, n));
+        return;
+    }
+
+    ts.a = a;
+    ts.tmp = NULL;
+    ts.tmp_size = 0;
+    ts.min_gallop = MIN_GALLOP;
+    ts.nruns = 0;
+
+    minrun = min_run_length(n);
+    do
+    {
+        int len = count_run(a, lo, lo + left);
+
+        //extend short runs to minrun elements
+        if(len < minrun)
+        {
+            int force = (left < minrun) ? left : minrun;
+            binary_insertion_sort(a, lo, lo + force, lo + len);
+            len = force;
+        }
+
+        ts.runs[ts.nruns].base = lo;
+        ts.runs[ts.nruns].len = len;
+        ts.nruns++;
+
+        if(!merge_collapse(&ts))
+            break;
+
+        lo += len;
+        left -= len;
+    }while(left);
+
+    //a failed merge moves nothing, so the array is still a permutation of the input
+    if(left || !merge_force_collapse(&ts))
+        quicksort(a, 0, n - 1);
+
+    free(ts.tmp);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file    check.h
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Checks shared by the programs run by 'make test'. Each program compares the
+ * library against a simple reference and exits with 1 if any check failed
+ */
+
+static int check_failures = 0;
+
+/**
+ * @brief Count and report a failed condition, with a printf-style message
+ */
+#define CHECK(cond, ...)                                            \
+do{                                                                 \
+    if(!(cond))                                                     \
+    {                                                               \
+        if(check_failures++ < 20)                                   \
+        {                                                           \
+            fprintf(stderr, "%s:%d: ", __FILE__, __LINE__);         \
+            fprintf(stderr, __VA_ARGS__);                           \
+            fprintf(stderr, "\n");                                  \
+        }                                                           \
+    }                                                               \
+}while(0)
+
+static uint64_t check_rng_state = 88172645463325252ull;
+
+/**
+ * @brief xorshift64, so every run checks the same inputs
+ */
+static inline
+uint64_t check_rng(void)
+{
+    check_rng_state ^= check_rng_state << 13;
+    check_rng_state ^= check_rng_state >> 7;
+    check_rng_state ^= check_rng_state << 17;
+
+    return check_rng_state;
+}
+
+/**
+ * @brief Uniform integer in [lo, hi]
+ */
+static inline
+int check_range(int lo, int hi)
+{
+    return lo + (int)(check_rng() % ((uint64_t)hi - lo + 1));
+}
+
+/**
+ * @brief Print the outcome of a test program
+ *
+ * @return exit status, 1 if any check failed
+ */
+static inline
+int check_report(const char* name)
+{
+    if(check_failures)
+        printf("%-14s FAILED (%d checks)\n", name, check_failures);
+    else
+        printf("%-14s ok\n", name);
+
+    return check_failures != 0;
+}
+
+#endif
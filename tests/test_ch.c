@@ -0,0 +1,388 @@
+/**
+ * @file    test_ch.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../inc/ch.h"
+#include "check.h"
+
+// sources of the queries checked on each graph, every vertex is a destination
+#define SOURCES     12
+
+#define THREADS     4
+
+/**
+ * @brief Lightest edge from u to v, LLONG_MAX if there is none
+ */
+static
+long long edge_weight(graph_t* g, int u, int v)
+{
+    long long w = LLONG_MAX;
+
+    for(struct node* e = g->adj[u]; e; e = e->next)
+    {
+        if(e->v == v && e->w < w)
+            w = e->w;
+    }
+
+    return w;
+}
+
+/**
+ * @brief Shortest path costs from every checked source, by dijkstra(),
+ *        itself checked against Bellman-Ford by test_graphs
+ */
+static
+int* reference(graph_t* g)
+{
+    int* ref = malloc((size_t)SOURCES * g->nv * sizeof(int));
+
+    for(int i = 0; i < SOURCES; i++)
+    {
+        sssp_t* s = dijkstra(g, i * g->nv / SOURCES);
+
+        memcpy(ref + (size_t)i * g->nv, s->cost, g->nv * sizeof(int));
+        free(s->cost);
+        free(s->prev);
+        free(s);
+    }
+
+    return ref;
+}
+
+/**
+ * @brief Every query from the checked sources, with the unpacked paths
+ */
+static
+void check_queries(graph_t* g, const ch_t* ch, const int* ref, const char* name)
+{
+    ch_query_t* q = ch_query_create(ch);
+    int wrong = 0, paths = 0;
+
+    for(int i = 0; i < SOURCES; i++)
+    {
+        int src = i * g->nv / SOURCES;
+
+        for(int dst = 0; dst < g->nv; dst++)
+        {
+            path_t path;
+            int c = ch_query(q, src, dst, &path);
+            long long sum = 0;
+
+            if(c != ref[(size_t)i * g->nv + dst])
+            {
+                wrong++;
+                free(path.v);
+                continue;
+            }
+
+            if(c == INT_MAX)
+            {
+                paths += path.n != 0;
+                free(path.v);
+                continue;
+            }
+
+            for(int j = 0; j + 1 < path.n && sum != LLONG_MAX; j++)
+            {
+                long long w = edge_weight(g, path.v[j], path.v[j + 1]);
+                sum = w == LLONG_MAX ? LLONG_MAX : sum + w;
+            }
+
+            paths += path.n == 0 || path.v[0] != src || path.v[path.n - 1] != dst || sum != c;
+            free(path.v);
+        }
+    }
+
+    CHECK(wrong == 0, "%s: %d wrong costs", name, wrong);
+    CHECK(paths == 0, "%s: %d wrong paths", name, paths);
+
+    ch_query_destroy(q);
+}
+
+typedef struct run_s
+{
+    const ch_t*     ch;
+    const int*      ref;
+    int             nv;
+    int             id;
+    int             wrong;
+
+}run_t;
+
+static
+void* query_worker(void* arg)
+{
+    run_t* run = arg;
+    ch_query_t* q = ch_query_create(run->ch);
+
+    for(int k = 0; k < 2000; k++)
+    {
+        int i = (k + run->id) % SOURCES;
+        int dst = (k * 7919 + run->id) % run->nv;
+
+        if(ch_query(q, i * run->nv / SOURCES, dst, NULL) != run->ref[(size_t)i * run->nv + dst])
+            run->wrong++;
+    }
+
+    ch_query_destroy(q);
+
+    return NULL;
+}
+
+/**
+ * @brief Threads querying one hierarchy at once, each with its own context
+ */
+static
+void check_threads(int nv, const ch_t* ch, const int* ref, const char* name)
+{
+    pthread_t th[THREADS];
+    run_t run[THREADS];
+
+    for(int t = 0; t < THREADS; t++)
+    {
+        run[t] = (run_t){ch, ref, nv, t, 0};
+        pthread_create(&th[t], NULL, query_worker, &run[t]);
+    }
+
+    for(int t = 0; t < THREADS; t++)
+    {
+        pthread_join(th[t], NULL);
+        CHECK(run[t].wrong == 0, "%s: thread %d got %d wrong costs", name, t, run[t].wrong);
+    }
+}
+
+static
+bool same_graph(const csr_graph_t* a, const int* amid, const csr_graph_t* b, const int* bmid)
+{
+    return a->nv == b->nv && a->ne == b->ne &&
+           memcmp(a->offset, b->offset, (a->nv + 1) * sizeof(int)) == 0 &&
+           memcmp(a->target, b->target, a->ne * sizeof(int)) == 0 &&
+           memcmp(a->weight, b->weight, a->ne * sizeof(int)) == 0 &&
+           memcmp(amid, bmid, a->ne * sizeof(int)) == 0;
+}
+
+/**
+ * @brief Write buf with the int at byte off replaced by v, or cut at n bytes, and load it back
+ */
+static
+ch_t* load_patched(const char* file, const char* buf, long n, long off, int v)
+{
+    char* copy = malloc(n);
+    FILE* f = fopen(file, "wb");
+    ch_t* ch;
+
+    memcpy(copy, buf, n);
+    if(off >= 0 && off + 4 <= n)
+        memcpy(copy + off, &v, sizeof(int));
+
+    fwrite(copy, 1, n, f);
+    fclose(f);
+    free(copy);
+
+    ch = ch_load(file);
+    return ch;
+}
+
+/**
+ * @brief Save and load give back the same hierarchy, and files that break
+ *        its rules are rejected
+ */
+static
+void check_save_load(graph_t* g, const ch_t* ch, const int* ref, const char* name)
+{
+    char file[] = "/tmp/ch_testXXXXXX";
+    int fd = mkstemp(file);
+    int nv = ch->nv, ne = ch->up->ne;
+    long header = 8 + 4L * nv;                      // magic, nv and rank
+    long offsets = header + 4;                      // after the upward edge count
+    long targets = offsets + 4L * (nv + 1);
+    long weights = targets + 4L * ne;
+    long mids = weights + 4L * ne;
+    int shortcut = -1, low = -1;
+    char* buf;
+    long n;
+    FILE* f;
+    ch_t* l;
+
+    CHECK(fd >= 0, "%s: cannot create a temporary file", name);
+    if(fd < 0)
+        return;
+    close(fd);
+
+    CHECK(ch_save(ch, file), "%s: ch_save failed", name);
+    l = ch_load(file);
+    CHECK(l != NULL, "%s: ch_load failed", name);
+    if(l == NULL)
+    {
+        unlink(file);
+        return;
+    }
+
+    CHECK(l->nv == nv && memcmp(l->rank, ch->rank, nv * sizeof(int)) == 0 &&
+          memcmp(l->vertex, ch->vertex, nv * sizeof(int)) == 0, "%s: ranks differ after loading", name);
+    CHECK(same_graph(l->up, l->up_mid, ch->up, ch->up_mid), "%s: upward graph differs after loading", name);
+    CHECK(same_graph(l->down, l->down_mid, ch->down, ch->down_mid), "%s: downward graph differs after loading", name);
+    check_queries(g, l, ref, name);
+    ch_destroy(l);
+
+    f = fopen(file, "rb");
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    rewind(f);
+    buf = malloc(n);
+    CHECK(fread(buf, 1, n, f) == (size_t)n, "%s: cannot read back the file", name);
+    fclose(f);
+
+    //an upward edge with a bypassed vertex, and a vertex with edges
+    for(int e = 0; e < ne && shortcut == -1; e++)
+    {
+        if(ch->up_mid[e] != -1)
+            shortcut = e;
+    }
+    for(int r = 0; r < nv && low == -1; r++)
+    {
+        if(ch->up->offset[r + 1] > ch->up->offset[r])
+            low = r;
+    }
+
+    struct { const char* what; long off; int v; } bad[] =
+    {
+        {"magic", 0, 0},
+        {"negative vertex count", 4, -1},
+        {"repeated rank", 8 + 4, ch->rank[0]},
+        {"rank out of range", 8, nv},
+        {"edge count", header, ne + 1},
+        {"first offset", offsets, 1},
+        {"last offset", offsets + 4L * nv, ne - 1},
+        {"decreasing offset", offsets + 4L * (low + 1), ch->up->offset[low] - 1},
+        {"target out of range", targets + 4L * ch->up->offset[low], nv},
+        {"target below its vertex", targets + 4L * ch->up->offset[low], low},
+        {"negative weight", weights + 4L * ch->up->offset[low], -1},
+        {"mid out of range", mids + 4L * ch->up->offset[low], -2},
+        {"mid above its vertex", shortcut >= 0 ? mids + 4L * shortcut : -1, nv - 1},
+    };
+
+    for(int i = 0; i < (int)(sizeof(bad) / sizeof(bad[0])); i++)
+    {
+        if(bad[i].off < 0)
+            continue;
+
+        l = load_patched(file, buf, n, bad[i].off, bad[i].v);
+        CHECK(l == NULL, "%s: file with a bad %s loaded", name, bad[i].what);
+        ch_destroy(l);
+    }
+
+    for(long cut = 0; cut < n; cut += n / 17 + 1)
+    {
+        l = load_patched(file, buf, cut, -1, 0);
+        CHECK(l == NULL, "%s: file cut at %ld of %ld bytes loaded", name, cut, n);
+        ch_destroy(l);
+    }
+
+    CHECK(ch_load("/nonexistent/ch") == NULL, "%s: missing file loaded", name);
+
+    free(buf);
+    unlink(file);
+}
+
+/**
+ * @brief Hierarchies without vertices or edges save and load like any other
+ */
+static
+void test_small(void)
+{
+    char file[] = "/tmp/ch_testXXXXXX";
+    int fd = mkstemp(file);
+
+    CHECK(fd >= 0, "small: cannot create a temporary file");
+    if(fd < 0)
+        return;
+    close(fd);
+
+    for(int nv = 0; nv <= 2; nv++)
+    {
+        graph_t* g = create_graph(nv, DIRECTED);
+        ch_t* ch = ch_build(g);
+        ch_t* l;
+
+        CHECK(ch_save(ch, file), "%d vertices: ch_save failed", nv);
+        l = ch_load(file);
+        CHECK(l != NULL && l->nv == nv && l->up->ne == 0 && l->down->ne == 0, "%d vertices: ch_load failed", nv);
+
+        if(l && nv)
+        {
+            ch_query_t* q = ch_query_create(l);
+
+            CHECK(ch_query(q, 0, 0, NULL) == 0, "%d vertices: wrong cost from 0 to itself", nv);
+            CHECK(nv < 2 || ch_query(q, 0, 1, NULL) == INT_MAX, "%d vertices: path without edges", nv);
+            ch_query_destroy(q);
+        }
+
+        ch_destroy(l);
+        ch_destroy(ch);
+        destroy_graph(g);
+    }
+
+    unlink(file);
+}
+
+static
+void test_graph(graph_t* g, const char* name)
+{
+    ch_t* ch = ch_build(g);
+    int* ref = reference(g);
+
+    check_queries(g, ch, ref, name);
+    check_threads(g->nv, ch, ref, name);
+    check_save_load(g, ch, ref, name);
+
+    ch_destroy(ch);
+    destroy_graph(g);
+    free(ref);
+}
+
+int main(void)
+{
+    int side = 30;
+    graph_t* g = create_graph(side * side, DIRECTED);
+
+    //grid with different weights each way, some of them 0
+    for(int v = 0; v < side * side; v++)
+    {
+        if(v % side + 1 < side)
+        {
+            add_edge(g, v, v + 1, check_range(0, 100));
+            add_edge(g, v + 1, v, check_range(0, 100));
+        }
+        if(v / side + 1 < side)
+        {
+            add_edge(g, v, v + side, check_range(0, 100));
+            add_edge(g, v + side, v, check_range(0, 100));
+        }
+    }
+    test_graph(g, "grid");
+
+    //sparse directed graph, with unreachable pairs, self loops and parallel edges
+    g = create_graph(400, DIRECTED);
+    for(int i = 0; i < 400 * 2; i++)
+        add_edge(g, check_range(0, 399), check_range(0, 399), check_range(1, 50));
+    test_graph(g, "random directed");
+
+    g = create_graph(400, UNDIRECTED);
+    for(int i = 0; i < 400 * 2; i++)
+        add_edge(g, check_range(0, 399), check_range(0, 399), check_range(1, 50));
+    test_graph(g, "random undirected");
+
+    test_small();
+
+    return check_report("test_ch");
+}
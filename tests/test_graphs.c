@@ -0,0 +1,479 @@
+/**
+ * @file    test_graphs.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../inc/graphs.h"
+#include "../inc/csr.h"
+#include "../inc/edgelist.h"
+#include "../inc/p2p.h"
+#include "check.h"
+
+/**
+ * @brief Reference single source shortest paths: Bellman-Ford over every edge,
+ *        in 64 bits, with unit weights if hops is set
+ *
+ * @return false if a negative cycle is reachable from src
+ */
+static
+bool ref_sssp(graph_t* g, int src, bool hops, long long* cost)
+{
+    for(int v = 0; v < g->nv; v++)
+        cost[v] = LLONG_MAX;
+    cost[src] = 0;
+
+    for(int pass = 0; pass <= g->nv; pass++)
+    {
+        bool changed = false;
+
+        for(int u = 0; u < g->nv; u++)
+        {
+            if(cost[u] == LLONG_MAX)
+                continue;
+
+            for(struct node* e = g->adj[u]; e; e = e->next)
+            {
+                long long c = cost[u] + (hops ? 1 : e->w);
+
+                if(c < cost[e->v])
+                {
+                    cost[e->v] = c;
+                    changed = true;
+                }
+            }
+        }
+
+        if(!changed)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Lightest edge from u to v, LLONG_MAX if there is none
+ */
+static
+long long edge_weight(graph_t* g, int u, int v)
+{
+    long long w = LLONG_MAX;
+
+    for(struct node* e = g->adj[u]; e; e = e->next)
+    {
+        if(e->v == v && e->w < w)
+            w = e->w;
+    }
+
+    return w;
+}
+
+/**
+ * @brief Compare a result with the reference: the costs must match, and every
+ *        reached vertex but src must have a parent whose edge gives its cost
+ */
+static
+void check_sssp(graph_t* g, int src, bool hops, const long long* ref, sssp_t* s, const char* name)
+{
+    int wrong = 0, parents = 0;
+
+    CHECK(s != NULL, "%s: no result from %d", name, src);
+    if(s == NULL)
+        return;
+
+    for(int v = 0; v < g->nv; v++)
+    {
+        long long c = s->cost[v] == INT_MAX ? LLONG_MAX : s->cost[v];
+        int p = s->prev[v];
+
+        if(c != ref[v])
+            wrong++;
+        else if(v != src && c != LLONG_MAX)
+        {
+            long long w = p < 0 || p >= g->nv ? LLONG_MAX : edge_weight(g, p, v);
+
+            if(hops && w != LLONG_MAX)
+                w = 1;
+
+            if(w == LLONG_MAX || ref[p] + w != c)
+                parents++;
+        }
+    }
+
+    CHECK(wrong == 0, "%s: %d wrong costs from %d", name, wrong, src);
+    CHECK(parents == 0, "%s: %d wrong parents from %d", name, parents, src);
+
+    free(s->cost);
+    free(s->prev);
+    free(s);
+}
+
+/**
+ * @brief A path from src to dst over edges of g whose weights add up to cost
+ */
+static
+void check_path(graph_t* g, int src, int dst, long long cost, path_t* path, const char* name)
+{
+    long long sum = 0;
+
+    if(cost == LLONG_MAX)
+    {
+        CHECK(path->n == 0, "%s: path to unreachable %d", name, dst);
+        free(path->v);
+        return;
+    }
+
+    CHECK(path->n > 0 && path->v[0] == src && path->v[path->n - 1] == dst, "%s: path does not go from %d to %d", name, src, dst);
+
+    for(int i = 0; i + 1 < path->n && sum != LLONG_MAX; i++)
+    {
+        long long w = edge_weight(g, path->v[i], path->v[i + 1]);
+        sum = w == LLONG_MAX ? LLONG_MAX : sum + w;
+    }
+
+    CHECK(sum == cost, "%s: path from %d to %d costs %lld instead of %lld", name, src, dst, sum, cost);
+    free(path->v);
+}
+
+/**
+ * @brief Random graph with about deg edges per vertex, weights in [lo, hi]
+ */
+static
+graph_t* random_graph(int nv, bool dir, int deg, int lo, int hi)
+{
+    graph_t* g = create_graph(nv, dir);
+
+    for(int i = 0; i < nv * deg; i++)
+        add_edge(g, check_range(0, nv - 1), check_range(0, nv - 1), check_range(lo, hi));
+
+    return g;
+}
+
+/**
+ * @brief side x side grid with both directions of every edge, weights in [1, hi]
+ */
+static
+graph_t* grid_graph(int side, int hi)
+{
+    graph_t* g = create_graph(side * side, DIRECTED);
+
+    for(int v = 0; v < side * side; v++)
+    {
+        if(v % side + 1 < side)
+        {
+            add_edge(g, v, v + 1, check_range(1, hi));
+            add_edge(g, v + 1, v, check_range(1, hi));
+        }
+        if(v / side + 1 < side)
+        {
+            add_edge(g, v, v + side, check_range(1, hi));
+            add_edge(g, v + side, v, check_range(1, hi));
+        }
+    }
+
+    return g;
+}
+
+/**
+ * @brief Every single source algorithm on a graph with non-negative weights
+ */
+static
+void test_sssp(graph_t* g)
+{
+    static const struct { const char* name; int pq; } pqs[] =
+    {
+        {"dijkstra_with/binary", PQ_BINARY_HEAP},
+        {"dijkstra_with/dary", PQ_DARY_HEAP},
+        {"dijkstra_with/radix", PQ_RADIX_HEAP},
+        {"dijkstra_with/bucket", PQ_BUCKET_QUEUE},
+    };
+    long long* ref = malloc(g->nv * sizeof(long long));
+    long long* hops = malloc(g->nv * sizeof(long long));
+    csr_graph_t* csr = csr_from_graph(g);
+    csr_graph_t* in = csr_transpose(csr);
+    edge_list_t* el = edge_list_from_graph(g);
+
+    for(int src = 0; src < g->nv; src += g->nv / 5 + 1)
+    {
+        ref_sssp(g, src, false, ref);
+        ref_sssp(g, src, true, hops);
+
+        check_sssp(g, src, false, ref, dijkstra(g, src), "dijkstra");
+        for(int q = 0; q < 4; q++)
+            check_sssp(g, src, false, ref, dijkstra_with(g, src, pqs[q].pq), pqs[q].name);
+        check_sssp(g, src, false, ref, bellman_ford(g, src), "bellman_ford");
+        check_sssp(g, src, false, ref, spfa(g, src, NULL), "spfa");
+        check_sssp(g, src, false, ref, delta_stepping(g, src, 0, 1), "delta_stepping/1");
+        check_sssp(g, src, false, ref, delta_stepping(g, src, 3, 4), "delta_stepping/4");
+        check_sssp(g, src, false, ref, csr_dijkstra(csr, src), "csr_dijkstra");
+        check_sssp(g, src, false, ref, csr_bellman_ford(csr, src), "csr_bellman_ford");
+        check_sssp(g, src, false, ref, edge_list_bellman_ford(el, src, 1), "edge_list_bellman_ford/1");
+        check_sssp(g, src, false, ref, edge_list_bellman_ford(el, src, 4), "edge_list_bellman_ford/4");
+
+        check_sssp(g, src, true, hops, bfs(g, src), "bfs");
+        check_sssp(g, src, true, hops, csr_bfs(csr, src), "csr_bfs");
+        check_sssp(g, src, true, hops, csr_bfs_do(csr, NULL, src), "csr_bfs_do");
+        check_sssp(g, src, true, hops, csr_bfs_do(csr, in, src), "csr_bfs_do/in");
+        check_sssp(g, src, true, hops, csr_parallel_bfs(csr, src, 4), "csr_parallel_bfs");
+    }
+
+    csr_destroy(csr);
+    csr_destroy(in);
+    edge_list_destroy(el);
+    free(ref);
+    free(hops);
+}
+
+/**
+ * @brief Point-to-point queries against the reference, with their paths.
+ *        A* gets the straight-line distance on the grid, where every edge weighs at least 1
+ */
+static
+void test_p2p(graph_t* g, int side)
+{
+    long long* ref = malloc(g->nv * sizeof(long long));
+    double* x = malloc(g->nv * sizeof(double));
+    double* y = malloc(g->nv * sizeof(double));
+    p2p_coords_t coords = {x, y, 1.0};
+    p2p_t* p = p2p_create(g);
+
+    for(int v = 0; v < g->nv; v++)
+    {
+        x[v] = side ? v % side : 0;
+        y[v] = side ? v / side : 0;
+    }
+
+    for(int src = 0; src < g->nv; src += g->nv / 7 + 1)
+    {
+        ref_sssp(g, src, false, ref);
+
+        for(int dst = 0; dst < g->nv; dst += g->nv / 31 + 1)
+        {
+            long long r = ref[dst];
+            path_t path;
+            int c;
+
+            c = p2p_dijkstra(p, src, dst, &path);
+            CHECK((c == INT_MAX ? LLONG_MAX : c) == r, "p2p_dijkstra: %d to %d costs %d instead of %lld", src, dst, c, r);
+            check_path(g, src, dst, r, &path, "p2p_dijkstra");
+            CHECK(!g->dir || (p->rev != NULL) == (src || dst), "p2p: transpose %s before the first bidirectional query",
+                  p->rev ? "built" : "missing");
+
+            c = p2p_bidirectional(p, src, dst, &path);
+            CHECK((c == INT_MAX ? LLONG_MAX : c) == r, "p2p_bidirectional: %d to %d costs %d instead of %lld", src, dst, c, r);
+            check_path(g, src, dst, r, &path, "p2p_bidirectional");
+
+            c = p2p_astar(p, src, dst, side ? p2p_euclidean : NULL, &coords, &path);
+            CHECK((c == INT_MAX ? LLONG_MAX : c) == r, "p2p_astar: %d to %d costs %d instead of %lld", src, dst, c, r);
+            check_path(g, src, dst, r, &path, "p2p_astar");
+        }
+    }
+
+    p2p_destroy(p);
+    free(x);
+    free(y);
+    free(ref);
+}
+
+/**
+ * @brief Negative weights without negative cycles: w(u,v) + pot[u] - pot[v]
+ *        keeps the cost of every cycle of the non-negative weights w
+ */
+static
+void test_negative_weights(void)
+{
+    int nv = 300;
+    graph_t* g = create_graph(nv, DIRECTED);
+    long long* ref = malloc(nv * sizeof(long long));
+    int* pot = malloc(nv * sizeof(int));
+    csr_graph_t* csr;
+    edge_list_t* el;
+
+    for(int v = 0; v < nv; v++)
+        pot[v] = check_range(0, 50);
+    for(int i = 0; i < nv * 4; i++)
+    {
+        int u = check_range(0, nv - 1), v = check_range(0, nv - 1);
+        add_edge(g, u, v, check_range(0, 20) + pot[u] - pot[v]);
+    }
+
+    csr = csr_from_graph(g);
+    el = edge_list_from_graph(g);
+
+    for(int src = 0; src < nv; src += 37)
+    {
+        CHECK(ref_sssp(g, src, false, ref), "reference: negative cycle from %d", src);
+
+        check_sssp(g, src, false, ref, bellman_ford(g, src), "bellman_ford");
+        check_sssp(g, src, false, ref, spfa(g, src, NULL), "spfa");
+        check_sssp(g, src, false, ref, csr_bellman_ford(csr, src), "csr_bellman_ford");
+        check_sssp(g, src, false, ref, edge_list_bellman_ford(el, src, 4), "edge_list_bellman_ford");
+    }
+
+    csr_destroy(csr);
+    edge_list_destroy(el);
+    destroy_graph(g);
+    free(ref);
+    free(pot);
+}
+
+/**
+ * @brief A negative cycle planted in a graph with positive weights must be reported,
+ *        and the one spfa extracts must be a real cycle of negative cost
+ */
+static
+void test_negative_cycle(void)
+{
+    for(int run = 0; run < 20; run++)
+    {
+        int nv = 200;
+        graph_t* g = random_graph(nv, DIRECTED, 3, 1, 100);
+        long long* ref = malloc(nv * sizeof(long long));
+        int len = check_range(1, 6);
+        int first = check_range(0, nv - 1);
+        int prev = first;
+        csr_graph_t* csr;
+        edge_list_t* el;
+        path_t cycle;
+        long long sum = 0;
+        bool distinct = true;
+        sssp_t* s;
+
+        //a cycle through len + 1 vertices, of total cost -1
+        for(int i = 0; i < len; i++)
+        {
+            int v = check_range(0, nv - 1);
+            add_edge(g, prev, v, 10);
+            prev = v;
+        }
+        add_edge(g, prev, first, -10 * len - 1);
+
+        //reachable from 0
+        add_edge(g, 0, first, 5);
+
+        csr = csr_from_graph(g);
+        el = edge_list_from_graph(g);
+
+        CHECK(!ref_sssp(g, 0, false, ref), "reference: no negative cycle in run %d", run);
+        CHECK(bellman_ford(g, 0) == NULL, "bellman_ford: negative cycle missed in run %d", run);
+        CHECK(csr_bellman_ford(csr, 0) == NULL, "csr_bellman_ford: negative cycle missed in run %d", run);
+        CHECK(edge_list_bellman_ford(el, 0, 4) == NULL, "edge_list_bellman_ford: negative cycle missed in run %d", run);
+
+        s = spfa(g, 0, &cycle);
+        CHECK(s == NULL && cycle.n > 0, "spfa: negative cycle missed in run %d", run);
+
+        for(int i = 0; i < cycle.n && sum != LLONG_MAX; i++)
+        {
+            long long w = edge_weight(g, cycle.v[i], cycle.v[(i + 1) % cycle.n]);
+            sum = w == LLONG_MAX ? LLONG_MAX : sum + w;
+
+            for(int j = 0; j < i; j++)
+                distinct &= cycle.v[j] != cycle.v[i];
+        }
+
+        CHECK(cycle.n == 0 || (sum < 0 && distinct), "spfa: extracted cycle of %d vertices is not a negative cycle in run %d", cycle.n, run);
+
+        if(cycle.n)
+            free(cycle.v);
+        csr_destroy(csr);
+        edge_list_destroy(el);
+        destroy_graph(g);
+        free(ref);
+    }
+}
+
+/**
+ * @brief A weight the queue cannot take must give no result rather than wrong costs
+ */
+static
+void test_rejected_weights(void)
+{
+    graph_t* g = create_graph(3, DIRECTED);
+
+    //2 is reached at cost 5 after 1 was extracted at cost 10
+    add_edge(g, 0, 1, 10);
+    add_edge(g, 1, 2, -5);
+
+    CHECK(dijkstra_with(g, 0, PQ_RADIX_HEAP) == NULL, "dijkstra_with/radix: negative weight accepted");
+    CHECK(dijkstra_with(g, 0, PQ_BUCKET_QUEUE) == NULL, "dijkstra_with/bucket: negative weight accepted");
+
+    destroy_graph(g);
+}
+
+/**
+ * @brief The transpose holds each edge reversed, and removed edges leave the
+ *        searches consistent while their nodes are reused
+ */
+static
+void test_graph_edits(void)
+{
+    int nv = 200;
+    graph_t* g = random_graph(nv, DIRECTED, 4, 1, 50);
+    graph_t* t = transpose_graph(g);
+    long long* ref = malloc((nv + 1) * sizeof(long long));
+    int count = 0, tcount = 0;
+
+    for(int u = 0; u < nv; u++)
+    {
+        for(struct node* e = g->adj[u]; e; e = e->next, count++)
+            CHECK(edge_weight(t, e->v, u) <= e->w, "transpose_graph: edge %d -> %d missing", u, e->v);
+        for(struct node* e = t->adj[u]; e; e = e->next)
+            tcount++;
+    }
+    CHECK(count == tcount, "transpose_graph: %d edges instead of %d", tcount, count);
+
+    for(int i = 0; i < nv * 2; i++)
+    {
+        int u = check_range(0, nv - 1);
+
+        if(g->adj[u])
+            CHECK(remove_edge(g, u, g->adj[u]->v), "remove_edge: edge out of %d not found", u);
+        add_edge(g, check_range(0, nv - 1), check_range(0, nv - 1), check_range(1, 50));
+    }
+
+    add_vertex(g);
+    ref_sssp(g, 0, false, ref);
+    check_sssp(g, 0, false, ref, dijkstra(g, 0), "dijkstra after edits");
+
+    destroy_graph(g);
+    destroy_graph(t);
+    free(ref);
+}
+
+int main(void)
+{
+    graph_t* g;
+
+    g = random_graph(500, DIRECTED, 4, 1, 100);
+    test_sssp(g);
+    test_p2p(g, 0);
+    destroy_graph(g);
+
+    g = random_graph(500, UNDIRECTED, 2, 0, 20);
+    test_sssp(g);
+    test_p2p(g, 0);
+    destroy_graph(g);
+
+    //a sparse graph leaves vertices unreachable
+    g = random_graph(500, DIRECTED, 1, 1, 100);
+    test_sssp(g);
+    test_p2p(g, 0);
+    destroy_graph(g);
+
+    g = grid_graph(25, 10);
+    test_sssp(g);
+    test_p2p(g, 25);
+    destroy_graph(g);
+
+    test_negative_weights();
+    test_negative_cycle();
+    test_rejected_weights();
+    test_graph_edits();
+
+    return check_report("test_graphs");
+}
@@ -0,0 +1,491 @@
+/**
+ * @file    test_heap.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "../inc/heap.h"
+#include "../inc/dheap.h"
+#include "../inc/monoqueue.h"
+#include "../inc/multiqueue.h"
+#include "check.h"
+
+// keys of the priority queue checks
+#define NKEYS       500
+
+// operations of each random run
+#define NOPS        20000
+
+/**
+ * @brief Reference priority queue: the priority of every queued key, scanned in O(n)
+ */
+typedef struct ref_pq_s
+{
+    bool    in[NKEYS];
+    int     prio[NKEYS];
+    int     n;
+
+}ref_pq_t;
+
+static
+int ref_min(const ref_pq_t* r)
+{
+    int m = INT_MAX;
+
+    for(int k = 0; k < NKEYS; k++)
+    {
+        if(r->in[k] && r->prio[k] < m)
+            m = r->prio[k];
+    }
+
+    return m;
+}
+
+static
+int ref_max(const ref_pq_t* r)
+{
+    int m = INT_MIN;
+
+    for(int k = 0; k < NKEYS; k++)
+    {
+        if(r->in[k] && r->prio[k] > m)
+            m = r->prio[k];
+    }
+
+    return m;
+}
+
+/**
+ * @brief A free key picked at random, -1 if every key is queued
+ */
+static
+int ref_free_key(const ref_pq_t* r)
+{
+    int k = check_range(0, NKEYS - 1);
+
+    if(r->n == NKEYS)
+        return -1;
+
+    while(r->in[k])
+        k = (k + 1) % NKEYS;
+
+    return k;
+}
+
+/**
+ * @brief A queued key picked at random, -1 if none is
+ */
+static
+int ref_queued_key(const ref_pq_t* r)
+{
+    int k = check_range(0, NKEYS - 1);
+
+    if(r->n == 0)
+        return -1;
+
+    while(!r->in[k])
+        k = (k + 1) % NKEYS;
+
+    return k;
+}
+
+/**
+ * @brief Check an extracted pair against the reference and take it out
+ */
+static
+void ref_extract(ref_pq_t* r, const key_value_t* item, int expected, const char* name)
+{
+    bool known = item->key >= 0 && item->key < NKEYS && r->in[item->key];
+
+    CHECK(known && r->prio[item->key] == item->value && item->value == expected,
+          "%s: extracted (%d, %d), expected priority %d", name, item->key, item->value, expected);
+
+    if(known)
+    {
+        r->in[item->key] = false;
+        r->n--;
+    }
+}
+
+/**
+ * @brief Random inserts, decrease-keys (increase-keys on a max heap), deletes 
+ *        and extracts on the heap_t of heap.h
+ */
+static
+void test_heap(int type, bool indexed)
+{
+    const char* name = indexed ? "indexed_min_heap" : (type == MIN_HEAP ? "min_heap" : "max_heap");
+    heap_t* h = indexed ? indexed_min_heap(4) : heap_create(4, type);
+    ref_pq_t r = {{false}, {0}, 0};
+    bool max = type == MAX_HEAP;
+    key_value_t item;
+
+    for(int op = 0; op < NOPS; op++)
+    {
+        int c = check_range(0, 9);
+        int k;
+
+        if(c < 5 && (k = ref_free_key(&r)) >= 0)
+        {
+            r.in[k] = true;
+            r.prio[k] = check_range(-1000, 1000);
+            r.n++;
+            CHECK(max ? max_insert(h, k, r.prio[k]) : min_insert(h, k, r.prio[k]), "%s: cannot insert %d", name, k);
+        }
+        else if(c == 5 && (k = ref_queued_key(&r)) >= 0)
+        {
+            if(max)
+            {
+                r.prio[k] += check_range(0, 100);
+                max_increase_key(h, k, r.prio[k]);
+            }
+            else
+            {
+                r.prio[k] -= check_range(0, 100);
+                min_decrease_key(h, k, r.prio[k]);
+            }
+        }
+        else if(c == 6 && (k = ref_queued_key(&r)) >= 0)
+        {
+            CHECK(heap_contains(h, k) && heap_delete(h, k) == 1 && !heap_contains(h, k), "%s: cannot delete %d", name, k);
+            r.in[k] = false;
+            r.n--;
+        }
+        else if(r.n)
+        {
+            int expected = max ? ref_max(&r) : ref_min(&r);
+
+            CHECK((max ? extract_max(h, &item) : extract_min(h, &item)) == 1, "%s: empty with %d items left", name, r.n);
+            ref_extract(&r, &item, expected, name);
+        }
+
+        CHECK(h->ctr == r.n, "%s: holds %d items instead of %d", name, h->ctr, r.n);
+    }
+
+    CHECK(!indexed || (!min_insert(h, -1, 0) && h->ctr == r.n), "%s: negative key inserted", name);
+    CHECK(max ? !min_insert(h, 0, 0) && !extract_min(h, &item) : !max_insert(h, 0, 0) && !extract_max(h, &item),
+          "%s: operation of the other heap type accepted", name);
+
+    destroy_heap(h);
+}
+
+/**
+ * @brief heap_build and heap_meld give the same extraction order as sorting
+ */
+static
+void test_heap_build_meld(int type)
+{
+    const char* name = type == MIN_HEAP ? "min" : "max";
+    bool max = type == MAX_HEAP;
+    key_value_t pairs[NKEYS];
+    heap_t* a;
+    heap_t* b = heap_create(1, type);
+    key_value_t item;
+    int last = max ? INT_MAX : INT_MIN, n = 0;
+
+    for(int k = 0; k < NKEYS; k++)
+    {
+        pairs[k].key = k;
+        pairs[k].value = check_range(-50, 50);
+    }
+
+    a = heap_build(pairs, NKEYS / 2, type);
+    for(int k = NKEYS / 2; k < NKEYS; k++)
+        max ? max_insert(b, pairs[k].key, pairs[k].value) : min_insert(b, pairs[k].key, pairs[k].value);
+
+    CHECK(heap_meld(a, b), "heap_meld %s: failed", name);
+    CHECK(b->ctr == 0 && a->ctr == NKEYS, "heap_meld %s: %d and %d items", name, a->ctr, b->ctr);
+
+    while(max ? extract_max(a, &item) : extract_min(a, &item))
+    {
+        CHECK((max ? item.value <= last : item.value >= last) && pairs[item.key].value == item.value,
+              "heap_build %s: (%d, %d) out of order", name, item.key, item.value);
+        last = item.value;
+        n++;
+    }
+    CHECK(n == NKEYS, "heap_build %s: %d items extracted instead of %d", name, n, NKEYS);
+
+    destroy_heap(a);
+    destroy_heap(b);
+
+    if(max)
+        return;
+
+    //a negative key has no place in an indexed heap, nothing moves
+    a = indexed_min_heap(4);
+    b = min_heap(4);
+    min_insert(a, 0, 1);
+    min_insert(b, 1, 2);
+    min_insert(b, -1, 3);
+    CHECK(!heap_meld(a, b) && a->ctr == 1 && b->ctr == 2, "heap_meld: negative key melded into an indexed heap");
+
+    destroy_heap(a);
+    destroy_heap(b);
+}
+
+static
+int cmp_value(const void* x, const void* y)
+{
+    const key_value_t* a = x;
+    const key_value_t* b = y;
+
+    return (a->value > b->value) - (a->value < b->value);
+}
+
+static
+void test_topk(void)
+{
+    key_value_t pairs[NKEYS], out[NKEYS];
+
+    for(int k = 1; k <= NKEYS; k *= 3)
+    {
+        topk_t* t = topk_create(k);
+
+        for(int i = 0; i < NKEYS; i++)
+        {
+            pairs[i].key = i;
+            pairs[i].value = check_range(0, 10000);
+            topk_push(t, pairs[i].key, pairs[i].value);
+        }
+
+        qsort(pairs, NKEYS, sizeof(key_value_t), cmp_value);
+        CHECK(topk_result(t, out) == k, "topk: not %d items", k);
+        for(int i = 0; i < k; i++)
+            CHECK(out[i].value == pairs[i].value, "topk: item %d of %d is %d instead of %d", i, k, out[i].value, pairs[i].value);
+
+        topk_destroy(t);
+    }
+}
+
+/**
+ * @brief Random inserts, decrease-keys and extracts on every arity of dheap_t
+ */
+static
+void test_dheap(void)
+{
+    static const int arities[] = {2, 4, 8, 16};
+
+    CHECK(dheap_create(NKEYS, 3) == NULL, "dheap: arity 3 accepted");
+
+    for(int a = 0; a < 4; a++)
+    {
+        dheap_t* h = dheap_create(NKEYS, arities[a]);
+        ref_pq_t r = {{false}, {0}, 0};
+        key_value_t item;
+
+        for(int op = 0; op < NOPS; op++)
+        {
+            int c = check_range(0, 9);
+            int k;
+
+            if(c < 5 && (k = ref_free_key(&r)) >= 0)
+            {
+                r.in[k] = true;
+                r.prio[k] = check_range(-1000, 1000);
+                r.n++;
+                CHECK(dheap_insert(h, k, r.prio[k]), "dheap %d: insert of %d rejected", arities[a], k);
+                CHECK(!dheap_insert(h, k, 0), "dheap %d: second insert of %d accepted", arities[a], k);
+            }
+            else if(c < 7 && (k = ref_queued_key(&r)) >= 0)
+            {
+                r.prio[k] -= check_range(0, 100);
+                dheap_decrease_key(h, k, r.prio[k]);
+            }
+            else if(c == 7 && op % 100 == 0)
+            {
+                dheap_clear(h);
+                memset(&r, 0, sizeof(r));
+            }
+            else if(r.n)
+            {
+                int expected = ref_min(&r);
+
+                CHECK(dheap_extract_min(h, &item) == 1, "dheap %d: empty with %d items left", arities[a], r.n);
+                ref_extract(&r, &item, expected, "dheap");
+            }
+
+            CHECK(h->ctr == r.n, "dheap %d: holds %d items instead of %d", arities[a], h->ctr, r.n);
+        }
+
+        CHECK(!dheap_insert(h, -1, 0) && !dheap_insert(h, NKEYS, 0), "dheap %d: key out of range accepted", arities[a]);
+
+        dheap_destroy(h);
+    }
+}
+
+/**
+ * @brief Radix heap and bucket queue, with priorities never below the last one extracted
+ */
+static
+void test_monotone(bool bucket)
+{
+    const char* name = bucket ? "bucketq" : "rheap";
+    int max_weight = 100;
+    rheap_t* rh = bucket ? NULL : rheap_create();
+    bucketq_t* bq = bucket ? bucketq_create(max_weight) : NULL;
+    ref_pq_t r = {{false}, {0}, 0};
+    key_value_t item;
+    int last = 0;
+
+    for(int op = 0; op < NOPS; op++)
+    {
+        int k;
+
+        if(check_range(0, 1) && (k = ref_free_key(&r)) >= 0)
+        {
+            r.in[k] = true;
+            r.prio[k] = last + check_range(0, max_weight);
+            r.n++;
+
+            if(bucket)
+                CHECK(bucketq_insert(bq, k, r.prio[k]) == 1, "bucketq: insert of %d at %d rejected", k, r.prio[k]);
+            else
+                CHECK(rheap_insert(rh, k, r.prio[k]), "rheap: insert of %d at %d rejected", k, r.prio[k]);
+        }
+        else if(r.n)
+        {
+            int expected = ref_min(&r);
+            int got = bucket ? bucketq_extract_min(bq, &item) : rheap_extract_min(rh, &item);
+
+            CHECK(got == 1, "%s: empty with %d items left", name, r.n);
+            ref_extract(&r, &item, expected, name);
+            last = expected;
+        }
+    }
+
+    if(bucket)
+    {
+        CHECK(bucketq_insert(bq, 0, last + max_weight + 1) == 0, "bucketq: priority past the window accepted");
+        if(last > 0)
+            CHECK(bucketq_insert(bq, 0, last - 1) == 0, "bucketq: priority below the last extracted accepted");
+    }
+    else
+    {
+        CHECK(!rheap_insert(rh, 0, -1), "rheap: negative priority accepted");
+        if(last > 0)
+            CHECK(!rheap_insert(rh, 0, last - 1), "rheap: priority below the last extracted accepted");
+    }
+
+    rheap_destroy(rh);
+    bucketq_destroy(bq);
+}
+
+// items inserted by each thread of the MultiQueue check
+#define MQ_ITEMS    20000
+#define MQ_THREADS  4
+
+typedef struct mq_run_s
+{
+    multiqueue_t*   mq;
+    int             id;
+    int*            seen;       // times each key was extracted, by its thread
+    int             bad;        // items with a priority other than the one inserted
+
+}mq_run_t;
+
+static
+void* mq_worker(void* arg)
+{
+    mq_run_t* run = arg;
+
+    for(int i = 0; i < MQ_ITEMS; i++)
+    {
+        int k = run->id * MQ_ITEMS + i;
+        multiqueue_insert(run->mq, k, k % 1000);
+    }
+
+    return NULL;
+}
+
+static
+void* mq_extractor(void* arg)
+{
+    mq_run_t* run = arg;
+    key_value_t item;
+
+    while(multiqueue_extract_min(run->mq, &item))
+    {
+        if(item.key < 0 || item.key >= MQ_THREADS * MQ_ITEMS || item.value != item.key % 1000)
+            run->bad++;
+        else
+            run->seen[item.key]++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief MultiQueue: a single heap is exact, and concurrent threads get every item once
+ */
+static
+void test_multiqueue(void)
+{
+    multiqueue_t* mq = multiqueue_create(1, 1);
+    int n = MQ_THREADS * MQ_ITEMS;
+    int* seen = calloc(MQ_THREADS * n, sizeof(int));
+    pthread_t th[MQ_THREADS];
+    mq_run_t run[MQ_THREADS];
+    key_value_t item;
+    int last = INT_MIN;
+
+    for(int k = 0; k < NKEYS; k++)
+        multiqueue_insert(mq, k, check_range(0, 100));
+    for(int k = 0; k < NKEYS; k++)
+    {
+        CHECK(multiqueue_extract_min(mq, &item) == 1 && item.value >= last, "multiqueue: single heap out of order");
+        last = item.value;
+    }
+    CHECK(multiqueue_extract_min(mq, &item) == 0, "multiqueue: item left in a single heap");
+    multiqueue_destroy(mq);
+
+    mq = multiqueue_create(MQ_THREADS, 0);
+    for(int t = 0; t < MQ_THREADS; t++)
+    {
+        run[t] = (mq_run_t){mq, t, seen + t * n, 0};
+        pthread_create(&th[t], NULL, mq_worker, &run[t]);
+    }
+    for(int t = 0; t < MQ_THREADS; t++)
+        pthread_join(th[t], NULL);
+
+    for(int t = 0; t < MQ_THREADS; t++)
+        pthread_create(&th[t], NULL, mq_extractor, &run[t]);
+    for(int t = 0; t < MQ_THREADS; t++)
+        pthread_join(th[t], NULL);
+
+    for(int k = 0; k < n; k++)
+    {
+        int times = 0;
+
+        for(int t = 0; t < MQ_THREADS; t++)
+            times += seen[t * n + k];
+
+        CHECK(times == 1, "multiqueue: key %d extracted %d times", k, times);
+    }
+    for(int t = 0; t < MQ_THREADS; t++)
+        CHECK(run[t].bad == 0, "multiqueue: %d unknown items", run[t].bad);
+
+    multiqueue_destroy(mq);
+    free(seen);
+}
+
+int main(void)
+{
+    test_heap(MIN_HEAP, false);
+    test_heap(MAX_HEAP, false);
+    test_heap(MIN_HEAP, true);
+    test_heap_build_meld(MIN_HEAP);
+    test_heap_build_meld(MAX_HEAP);
+    test_topk();
+    test_dheap();
+    test_monotone(false);
+    test_monotone(true);
+    test_multiqueue();
+
+    return check_report("test_heap");
+}
@@ -0,0 +1,234 @@
+/**
+ * @file    test_queue.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "../inc/queue.h"
+#include "check.h"
+
+// items sent by each producer thread
+#define ITEMS       200000
+
+#define PRODUCERS   3
+#define CONSUMERS   3
+
+// largest batch moved at once
+#define BATCH       16
+
+/**
+ * @brief The growable queue against the order of insertion, with the ring 
+ *        wrapping around while it grows
+ */
+static
+void test_queue(void)
+{
+    queue_t q;
+    int head = 0, tail = 0, out;
+
+    CHECK(queue(&q, 3), "queue: cannot create");
+
+    for(int op = 0; op < 100000; op++)
+    {
+        //more enqueues while op is in the first half, more dequeues after
+        if(check_range(0, 99) < (op < 50000 ? 60 : 40))
+        {
+            CHECK(enqueue(&q, tail), "queue: enqueue failed");
+            tail++;
+        }
+        else if(head < tail)
+        {
+            CHECK(dequeue(&q, &out) && out == head, "queue: got %d instead of %d", out, head);
+            head++;
+        }
+
+        CHECK(q.ctr == tail - head, "queue: holds %d items instead of %d", q.ctr, tail - head);
+    }
+
+    while(head < tail)
+    {
+        CHECK(dequeue(&q, &out) && out == head, "queue: got %d instead of %d", out, head);
+        head++;
+    }
+
+    CHECK(!dequeue(&q, &out), "queue: item from an empty queue");
+    queue_delete(&q);
+}
+
+/**
+ * @brief A bounded queue holds exactly its rounded-up capacity
+ */
+static
+void test_capacity(void)
+{
+    spsc_t* s = spsc_create(5);
+    mpmc_t* m = mpmc_create(5);
+    int n, out;
+
+    for(n = 0; spsc_enqueue(s, n); n++)
+        ;
+    CHECK(n == 8, "spsc: holds %d items instead of 8", n);
+    for(int i = 0; i < n; i++)
+        CHECK(spsc_dequeue(s, &out) && out == i, "spsc: got %d instead of %d", out, i);
+    CHECK(!spsc_dequeue(s, &out), "spsc: item from an empty queue");
+
+    for(n = 0; mpmc_enqueue(m, n); n++)
+        ;
+    CHECK(n == 8, "mpmc: holds %d items instead of 8", n);
+    for(int i = 0; i < n; i++)
+        CHECK(mpmc_dequeue(m, &out) && out == i, "mpmc: got %d instead of %d", out, i);
+    CHECK(!mpmc_dequeue(m, &out), "mpmc: item from an empty queue");
+
+    spsc_destroy(s);
+    mpmc_destroy(m);
+}
+
+typedef struct run_s
+{
+    spsc_t*         spsc;
+    mpmc_t*         mpmc;
+    int             id;
+    atomic_int*     seen;       // times each item was received
+    int             bad;        // items out of order or unknown
+    atomic_long*    left;       // items not yet received
+
+}run_t;
+
+/**
+ * @brief Send 0 .. ITEMS-1 tagged with the producer, in singles and batches
+ */
+static
+void* producer(void* arg)
+{
+    run_t* run = arg;
+    int buf[BATCH];
+    int i = 0;
+
+    while(i < ITEMS)
+    {
+        int n = 1 + i % BATCH;
+
+        if(n > ITEMS - i)
+            n = ITEMS - i;
+
+        for(int j = 0; j < n; j++)
+            buf[j] = run->id * ITEMS + i + j;
+
+        if(n == 1)
+            n = run->spsc ? spsc_enqueue(run->spsc, buf[0]) : mpmc_enqueue(run->mpmc, buf[0]);
+        else
+            n = run->spsc ? spsc_enqueue_batch(run->spsc, buf, n) : mpmc_enqueue_batch(run->mpmc, buf, n);
+
+        //full: let the consumers run, there may be fewer cores than threads
+        if(n == 0)
+            sched_yield();
+        i += n;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Receive until every item is in. Items of one producer must arrive in order
+ */
+static
+void* consumer(void* arg)
+{
+    run_t* run = arg;
+    int last[PRODUCERS];
+    int buf[BATCH];
+    int round = 0;
+
+    for(int p = 0; p < PRODUCERS; p++)
+        last[p] = -1;
+
+    while(atomic_load(run->left) > 0)
+    {
+        size_t n;
+
+        if(round++ & 1)
+            n = run->spsc ? spsc_dequeue_batch(run->spsc, buf, BATCH) : mpmc_dequeue_batch(run->mpmc, buf, BATCH);
+        else
+            n = run->spsc ? spsc_dequeue(run->spsc, buf) : mpmc_dequeue(run->mpmc, buf);
+
+        for(size_t j = 0; j < n; j++)
+        {
+            int p = buf[j] / ITEMS;
+
+            if(buf[j] < 0 || p >= PRODUCERS || buf[j] <= last[p])
+            {
+                run->bad++;
+                continue;
+            }
+
+            last[p] = buf[j];
+            atomic_fetch_add(&run->seen[buf[j]], 1);
+        }
+
+        if(n == 0)
+            sched_yield();
+        atomic_fetch_sub(run->left, (long)n);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Producers and consumers on a small queue, so that it is often full and empty.
+ *        Every item must be received exactly once
+ */
+static
+void test_threads(bool spsc)
+{
+    const char* name = spsc ? "spsc" : "mpmc";
+    int np = spsc ? 1 : PRODUCERS, nc = spsc ? 1 : CONSUMERS;
+    atomic_int* seen = calloc(PRODUCERS * ITEMS, sizeof(atomic_int));
+    atomic_long left = (long)np * ITEMS;
+    pthread_t pt[PRODUCERS], ct[CONSUMERS];
+    run_t prun[PRODUCERS], crun[CONSUMERS];
+    spsc_t* s = spsc ? spsc_create(64) : NULL;
+    mpmc_t* m = spsc ? NULL : mpmc_create(64);
+
+    for(int p = 0; p < np; p++)
+    {
+        prun[p] = (run_t){s, m, p, seen, 0, &left};
+        pthread_create(&pt[p], NULL, producer, &prun[p]);
+    }
+    for(int c = 0; c < nc; c++)
+    {
+        crun[c] = (run_t){s, m, c, seen, 0, &left};
+        pthread_create(&ct[c], NULL, consumer, &crun[c]);
+    }
+
+    for(int p = 0; p < np; p++)
+        pthread_join(pt[p], NULL);
+    for(int c = 0; c < nc; c++)
+    {
+        pthread_join(ct[c], NULL);
+        CHECK(crun[c].bad == 0, "%s: consumer %d got %d items out of order", name, c, crun[c].bad);
+    }
+
+    for(int i = 0; i < np * ITEMS; i++)
+        CHECK(atomic_load(&seen[i]) == 1, "%s: item %d received %d times", name, i, atomic_load(&seen[i]));
+
+    spsc_destroy(s);
+    mpmc_destroy(m);
+    free(seen);
+}
+
+int main(void)
+{
+    test_queue();
+    test_capacity();
+    test_threads(true);
+    test_threads(false);
+
+    return check_report("test_queue");
+}
@@ -0,0 +1,248 @@
+/**
+ * @file    test_sort.c
+ * @authors Eduardo S. Pino (edsp)
+ * @version 1.0
+ * @date    18-10-2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include "../inc/sort.h"
+#include "../inc/sortnet.h"
+#include "check.h"
+
+#define DIST_RANDOM         0
+#define DIST_SORTED         1
+#define DIST_REVERSED       2
+#define DIST_FEW_UNIQUE     3
+#define DIST_ORGAN_PIPE     4
+#define DIST_EXTREMES       5
+#define NDIST               6
+
+static const char* dist_names[NDIST] = {"random", "sorted", "reversed", "few_unique", "organ_pipe", "extremes"};
+
+// sizes around the cut-offs of the sorting networks, runs and radix passes
+static const int sizes[] = {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 4097, 100000};
+
+#define NSIZES  ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static
+int cmp_int(const void* x, const void* y)
+{
+    int a = *(const int*)x, b = *(const int*)y;
+
+    return (a > b) - (a < b);
+}
+
+static
+void fill_array(int* a, int n, int dist)
+{
+    for(int i = 0; i < n; i++)
+    {
+        switch(dist)
+        {
+            case DIST_RANDOM:       a[i] = (int)check_rng(); break;
+            case DIST_SORTED:       a[i] = i; break;
+            case DIST_REVERSED:     a[i] = n - i; break;
+            case DIST_FEW_UNIQUE:   a[i] = check_range(-4, 4); break;
+            case DIST_ORGAN_PIPE:   a[i] = i < n / 2 ? i : n - i; break;
+            default:                a[i] = check_range(0, 2) == 0 ? INT_MIN : (check_range(0, 1) ? INT_MAX : 0); break;
+        }
+    }
+}
+
+static void run_mergesort(int* a, int n)            { mergesort(a, 0, n - 1); }
+static void run_bottomup_mergesort(int* a, int n)   { bottomup_mergesort(a, n, NULL); }
+static void run_parallel_mergesort(int* a, int n)   { parallel_mergesort(a, 0, n - 1, 4); }
+static void run_timsort(int* a, int n)              { timsort(a, n); }
+static void run_heapsort(int* a, int n)             { heapsort(a, n); }
+static void run_quicksort(int* a, int n)            { quicksort(a, 0, n - 1); }
+static void run_block_quicksort(int* a, int n)      { quicksort_with(a, 0, n - 1, PARTITION_BLOCK); }
+static void run_randomized_quicksort(int* a, int n) { randomized_quicksort(a, 0, n - 1); }
+static void run_parallel_quicksort(int* a, int n)   { parallel_quicksort(a, 0, n - 1, 4); }
+static void run_radix_sort(int* a, int n)           { radix_sort(a, n); }
+
+static void run_bottomup_mergesort_buf(int* a, int n)
+{
+    int* buf = malloc((n + 1) * sizeof(int));
+
+    bottomup_mergesort(a, n, buf);
+    free(buf);
+}
+
+static void run_sortnet(int* a, int n)
+{
+    if(n <= SORTNET_MAX)
+        sortnet_sort(a, n);
+    else
+        qsort(a, n, sizeof(int), cmp_int);
+}
+
+static const struct
+{
+    const char* name;
+    void (*run)(int* a, int n);
+
+}sorts[] =
+{
+    {"mergesort", run_mergesort},
+    {"bottomup_mergesort", run_bottomup_mergesort},
+    {"bottomup_mergesort/buf", run_bottomup_mergesort_buf},
+    {"parallel_mergesort", run_parallel_mergesort},
+    {"timsort", run_timsort},
+    {"heapsort", run_heapsort},
+    {"quicksort", run_quicksort},
+    {"block_quicksort", run_block_quicksort},
+    {"randomized_quicksort", run_randomized_quicksort},
+    {"parallel_quicksort", run_parallel_quicksort},
+    {"radix_sort", run_radix_sort},
+    {"sortnet_sort", run_sortnet},
+};
+
+#define NSORTS  ((int)(sizeof(sorts) / sizeof(sorts[0])))
+
+/**
+ * @brief Every sort against qsort, on every distribution and size
+ */
+static
+void test_sorts(void)
+{
+    int max = sizes[NSIZES - 1];
+    int* input = malloc(max * sizeof(int));
+    int* ref = malloc(max * sizeof(int));
+    int* a = malloc(max * sizeof(int));
+
+    for(int d = 0; d < NDIST; d++)
+    {
+        for(int k = 0; k < NSIZES; k++)
+        {
+            int n = sizes[k];
+
+            fill_array(input, n, d);
+            memcpy(ref, input, n * sizeof(int));
+            qsort(ref, n, sizeof(int), cmp_int);
+
+            for(int s = 0; s < NSORTS; s++)
+            {
+                memcpy(a, input, n * sizeof(int));
+                sorts[s].run(a, n);
+                CHECK(memcmp(a, ref, n * sizeof(int)) == 0, "%s: wrong result on %s n=%d", sorts[s].name, dist_names[d], n);
+            }
+        }
+    }
+
+    free(input);
+    free(ref);
+    free(a);
+}
+
+/**
+ * @brief Equal values must keep the order of their keys
+ */
+static
+void test_radix_sort_kv(void)
+{
+    for(int k = 0; k < NSIZES; k++)
+    {
+        int n = sizes[k];
+        key_value_t* a = malloc((n + 1) * sizeof(key_value_t));
+
+        for(int i = 0; i < n; i++)
+        {
+            a[i].key = i;
+            a[i].value = (k & 1) ? check_range(-3, 3) : (int)check_rng();
+        }
+
+        radix_sort_kv(a, n);
+
+        for(int i = 1; i < n; i++)
+        {
+            bool ordered = a[i - 1].value < a[i].value || (a[i - 1].value == a[i].value && a[i - 1].key < a[i].key);
+            CHECK(ordered, "radix_sort_kv: pairs %d and %d out of order, n=%d", i - 1, i, n);
+        }
+
+        free(a);
+    }
+}
+
+static
+void test_sortnet_merge(void)
+{
+    int x[SORTNET_MAX], y[SORTNET_MAX], out[2 * SORTNET_MAX], ref[2 * SORTNET_MAX];
+
+    for(int nx = 0; nx <= SORTNET_MAX; nx += 7)
+    {
+        for(int ny = 0; ny <= SORTNET_MAX; ny += 5)
+        {
+            fill_array(x, nx, DIST_RANDOM);
+            fill_array(y, ny, DIST_FEW_UNIQUE);
+            qsort(x, nx, sizeof(int), cmp_int);
+            qsort(y, ny, sizeof(int), cmp_int);
+
+            memcpy(ref, x, nx * sizeof(int));
+            memcpy(ref + nx, y, ny * sizeof(int));
+            qsort(ref, nx + ny, sizeof(int), cmp_int);
+
+            sortnet_merge(x, nx, y, ny, out);
+            CHECK(memcmp(out, ref, (nx + ny) * sizeof(int)) == 0, "sortnet_merge: wrong result for %d + %d", nx, ny);
+        }
+    }
+}
+
+/**
+ * @brief select_nth and partial_sort against a sorted copy
+ */
+static
+void test_selection(void)
+{
+    int n = 1000;
+    int* input = malloc(n * sizeof(int));
+    int* ref = malloc(n * sizeof(int));
+    int* a = malloc(n * sizeof(int));
+
+    for(int d = 0; d < NDIST; d++)
+    {
+        fill_array(input, n, d);
+        memcpy(ref, input, n * sizeof(int));
+        qsort(ref, n, sizeof(int), cmp_int);
+
+        for(int k = 0; k < n; k += 97)
+        {
+            bool split = true;
+
+            memcpy(a, input, n * sizeof(int));
+            select_nth(a, n, k);
+
+            for(int i = 0; i < n; i++)
+                split &= i < k ? a[i] <= a[k] : a[i] >= a[k];
+
+            CHECK(a[k] == ref[k], "select_nth: a[%d] = %d instead of %d on %s", k, a[k], ref[k], dist_names[d]);
+            CHECK(split, "select_nth: a[%d] does not split the array on %s", k, dist_names[d]);
+
+            memcpy(a, input, n * sizeof(int));
+            partial_sort(a, n, k);
+            CHECK(memcmp(a, ref, k * sizeof(int)) == 0, "partial_sort: wrong prefix of %d on %s", k, dist_names[d]);
+
+            //the rest must still be the other elements
+            qsort(a + k, n - k, sizeof(int), cmp_int);
+            CHECK(memcmp(a + k, ref + k, (n - k) * sizeof(int)) == 0, "partial_sort: lost elements, k=%d on %s", k, dist_names[d]);
+        }
+    }
+
+    free(input);
+    free(ref);
+    free(a);
+}
+
+int main(void)
+{
+    test_sorts();
+    test_radix_sort_kv();
+    test_sortnet_merge();
+    test_selection();
+
+    return check_report("test_sort");
+}